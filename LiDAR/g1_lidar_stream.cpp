@@ -1,16 +1,31 @@
 #include "livox_lidar_def.h"
 #include "livox_lidar_api.h"
+#include "lidar_transport.hpp"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <float.h>
 #include <unistd.h>
 #include <arpa/inet.h>
 #include <sys/socket.h>
 #include <signal.h>
 
-// UDP socket configuration
-int udp_socket;
-struct sockaddr_in viewer_addr;
+// Shared transport (SLAM/common/lidar_transport): SIMD filter/convert
+// kernel + sendmmsg-batched UDP transmit, same implementation the SLAM
+// sender links. The wire format is unchanged: headerless runs of packed
+// 13-byte points (lidar_viewer.py).
+using lidar_transport::Point3D;
+using lidar_transport::UdpSender;
+
+// Max filtered points per callback (the old fixed 96-point stack buffer
+// silently dropped everything above 96 when dot_num was larger)
+#define MAX_VIEWER_POINTS 2048
+
+// Points per datagram: 105 * 13 = 1365 bytes (safe below a 1500 MTU)
+#define POINTS_PER_DATAGRAM 105
+
+// UDP sender (shared transport library owns the socket + target address)
+UdpSender sender;
 
 // Graceful shutdown flag
 volatile sig_atomic_t keep_running = 1;
@@ -21,12 +36,6 @@ void signal_handler(int signum) {
     keep_running = 0;
 }
 
-// Compact point structure (packed, no padding - exactly 13 bytes)
-struct __attribute__((packed)) SimplePoint {
-    float x, y, z;      // 12 bytes (3D position in meters)
-    uint8_t intensity;  // 1 byte (reflectivity 0-255)
-};  // Total: 13 bytes (no padding)
-
 void PointCloudCallback(uint32_t handle, const uint8_t dev_type,
                         LivoxLidarEthernetPacket* data, void* client_data) {
     // Suppress unused parameter warnings
@@ -35,43 +44,60 @@ void PointCloudCallback(uint32_t handle, const uint8_t dev_type,
     (void)client_data;
 
     static int count = 0;
+    static int dropped = 0;
 
     if (data == nullptr) return;
 
     // Process only Cartesian coordinate data
-    if (data->data_type == kLivoxLidarCartesianCoordinateHighData) {
-        LivoxLidarCartesianHighRawPoint *points =
-            (LivoxLidarCartesianHighRawPoint *)data->data;
-
-        // Buffer for UDP transmission
-        SimplePoint buffer[96];
-        int valid_count = 0;
-
-        for (int i = 0; i < data->dot_num && i < 96; i++) {
-            // Skip invalid (0,0,0) points
-            if (points[i].x != 0 || points[i].y != 0 || points[i].z != 0) {
-                buffer[valid_count].x = points[i].x / 1000.0f;  // mm to m
-                buffer[valid_count].y = points[i].y / 1000.0f;
-                buffer[valid_count].z = points[i].z / 1000.0f;
-                buffer[valid_count].intensity = points[i].reflectivity;
-                valid_count++;
-            }
-        }
-
-        // Send if there are valid points
-        if (valid_count > 0) {
-            ssize_t sent = sendto(udp_socket, buffer, valid_count * sizeof(SimplePoint), 0,
-                                  (struct sockaddr*)&viewer_addr, sizeof(viewer_addr));
-
-            if (sent < 0) {
-                perror("sendto failed");
-            }
-
-            // Print status every 500 packets
-            if (++count % 500 == 0) {
-                printf("✓ Packet #%d: Streaming %d points\n", count, valid_count);
-            }
-        }
+    if (data->data_type != kLivoxLidarCartesianCoordinateHighData) {
+        return;
+    }
+
+    LivoxLidarCartesianHighRawPoint *points =
+        (LivoxLidarCartesianHighRawPoint *)data->data;
+
+    // Filter and convert via the shared kernel (SIMD when available).
+    // No range gate or downsampling for the viewer: only invalid (0,0,0)
+    // points are rejected, matching the original behavior.
+    static Point3D buffer[MAX_VIEWER_POINTS];
+    lidar_transport::FilterParams params;
+    params.min_range = 0.0f;
+    params.max_range = FLT_MAX;
+    params.downsample = 1;
+    params.keep = nullptr;
+    params.keep_ctx = nullptr;
+
+    int valid_count = lidar_transport::filter_convert_points(
+        points, data->dot_num, buffer, MAX_VIEWER_POINTS, params,
+        nullptr, nullptr);
+
+    if (valid_count <= 0) {
+        return;
+    }
+
+    // Segment into MTU-safe datagrams (iovecs point straight into the
+    // point buffer, no copies) and flush with one sendmmsg()
+    struct iovec iov[(MAX_VIEWER_POINTS + POINTS_PER_DATAGRAM - 1) / POINTS_PER_DATAGRAM];
+    int num_segments = 0;
+    for (int offset = 0; offset < valid_count; offset += POINTS_PER_DATAGRAM) {
+        int batch = valid_count - offset;
+        if (batch > POINTS_PER_DATAGRAM) batch = POINTS_PER_DATAGRAM;
+        iov[num_segments].iov_base = buffer + offset;
+        iov[num_segments].iov_len = (size_t)batch * sizeof(Point3D);
+        num_segments++;
+    }
+
+    UdpSender::FlushResult res;
+    sender.flush(iov, num_segments, &res);
+
+    if (res.eagain) {
+        dropped += num_segments - res.sent;
+    }
+
+    // Print status every 500 packets
+    if (++count % 500 == 0) {
+        printf("✓ Packet #%d: Streaming %d points (%d datagrams, %d dropped)\n",
+               count, valid_count, num_segments, dropped);
     }
 }
 
@@ -115,32 +141,19 @@ int main(int argc, char** argv) {
     printf("========================================\n");
     printf("Config:       %s\n", config_file);
     printf("Viewer:       %s:%d\n", viewer_ip, viewer_port);
-    printf("Data format:  SimplePoint (%zu bytes)\n", sizeof(SimplePoint));
+    printf("Data format:  Point3D (%zu bytes, %d pts/datagram)\n",
+           sizeof(Point3D), POINTS_PER_DATAGRAM);
     printf("----------------------------------------\n\n");
 
     // Register signal handler for graceful shutdown
     signal(SIGINT, signal_handler);
     signal(SIGTERM, signal_handler);
 
-    // Create UDP socket
-    udp_socket = socket(AF_INET, SOCK_DGRAM, 0);
-    if (udp_socket < 0) {
+    // Create UDP socket (5 second send timeout, as before)
+    if (!sender.open(viewer_ip, viewer_port, 5 * 1000000L, 0)) {
         printf("❌ ERROR: Failed to create UDP socket\n");
         return -1;
     }
-
-    // Set socket timeout (5 seconds)
-    struct timeval timeout;
-    timeout.tv_sec = 5;
-    timeout.tv_usec = 0;
-    if (setsockopt(udp_socket, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout)) < 0) {
-        printf("⚠ WARNING: Failed to set socket timeout\n");
-    }
-
-    memset(&viewer_addr, 0, sizeof(viewer_addr));
-    viewer_addr.sin_family = AF_INET;
-    viewer_addr.sin_port = htons(viewer_port);
-    inet_pton(AF_INET, viewer_ip, &viewer_addr.sin_addr);
     printf("✓ UDP socket created (target: %s:%d)\n", viewer_ip, viewer_port);
 
     // Initialize Livox SDK
@@ -163,7 +176,7 @@ int main(int argc, char** argv) {
 
     // Cleanup
     printf("Cleaning up resources...\n");
-    close(udp_socket);
+    sender.close();
     LivoxLidarSdkUninit();
     printf("✓ Shutdown complete\n");
     return 0;
@@ -0,0 +1,249 @@
+#ifndef LATENCY_HISTOGRAM_HPP
+#define LATENCY_HISTOGRAM_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+
+#include <signal.h>
+#include <unistd.h>
+
+// Latency Histogram - Log-bucketed (HDR-style) latency tracking
+//
+// Shared by the tx stats block (lidar_tx) and the rx profiling
+// (slam_rx frame builder). Mean-only profiling hides the tail events
+// that actually cause drops - a 3ms p99.9 under a 40us mean - so each
+// hot-path stage records into a fixed-size histogram instead:
+//
+//   - record_ns() is lock-free (one relaxed fetch_add per sample) and
+//     allocation-free, safe to call from the Livox callback, the sender
+//     thread, and the rx thread
+//   - ~3% value resolution: 32 sub-buckets per power-of-two octave,
+//     covering the full ns range in 1920 buckets (~15 KB per stage)
+//   - percentiles are computed at dump time by walking the buckets,
+//     never on the hot path
+//
+// Stages register by name in a fixed-capacity registry; dump() writes
+// with snprintf + write(2) only, so the SIGUSR1 handler installed by
+// install_sigusr1_dump() can print a live snapshot without stopping
+// the stream.
+
+namespace latency {
+
+// ============================================================================
+// LatencyHistogram - Lock-free log-bucketed histogram
+// ============================================================================
+
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BITS = 5;                   // 32 sub-buckets/octave
+    static constexpr int SUB_COUNT = 1 << SUB_BITS;
+    // Octaves 0..(63 - SUB_BITS) plus the sub-octave exact range: the top
+    // bucket_index() for v >= 2^63 is ((63 - SUB_BITS + 1) << SUB_BITS) | 31
+    static constexpr int BUCKET_COUNT = (64 - SUB_BITS + 1) * SUB_COUNT;
+
+    // Record one sample (lock-free, relaxed ordering)
+    void record_ns(uint64_t ns) {
+        counts_[bucket_index(ns)].fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+        sum_ns_.fetch_add(ns, std::memory_order_relaxed);
+
+        uint64_t prev = max_ns_.load(std::memory_order_relaxed);
+        while (ns > prev &&
+               !max_ns_.compare_exchange_weak(prev, ns,
+                                              std::memory_order_relaxed)) {
+        }
+    }
+
+    uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+
+    double mean_us() const {
+        uint64_t n = count();
+        return n > 0
+            ? (double)sum_ns_.load(std::memory_order_relaxed) / n / 1000.0
+            : 0.0;
+    }
+
+    double max_us() const {
+        return (double)max_ns_.load(std::memory_order_relaxed) / 1000.0;
+    }
+
+    // Percentile in microseconds (bucket midpoint; walk is read-only)
+    double percentile_us(double p) const {
+        uint64_t total = count();
+        if (total == 0) {
+            return 0.0;
+        }
+
+        uint64_t target = (uint64_t)(p * total);
+        if (target < 1) target = 1;
+
+        uint64_t seen = 0;
+        for (int i = 0; i < BUCKET_COUNT; i++) {
+            seen += counts_[i].load(std::memory_order_relaxed);
+            if (seen >= target) {
+                return (double)bucket_mid_ns(i) / 1000.0;
+            }
+        }
+        return max_us();
+    }
+
+    void reset() {
+        for (int i = 0; i < BUCKET_COUNT; i++) {
+            counts_[i].store(0, std::memory_order_relaxed);
+        }
+        count_.store(0, std::memory_order_relaxed);
+        sum_ns_.store(0, std::memory_order_relaxed);
+        max_ns_.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    static int bucket_index(uint64_t v) {
+        if (v < SUB_COUNT) {
+            return (int)v;  // Exact buckets below one octave
+        }
+        int msb = 63 - __builtin_clzll(v);
+        int shift = msb - SUB_BITS;
+        int sub = (int)((v >> shift) & (SUB_COUNT - 1));
+        return ((shift + 1) << SUB_BITS) | sub;
+    }
+
+    static uint64_t bucket_mid_ns(int idx) {
+        if (idx < SUB_COUNT) {
+            return (uint64_t)idx;
+        }
+        int shift = (idx >> SUB_BITS) - 1;
+        uint64_t base = ((uint64_t)(SUB_COUNT + (idx & (SUB_COUNT - 1)))) << shift;
+        return base + (((uint64_t)1 << shift) >> 1);
+    }
+
+    std::atomic<uint64_t> counts_[BUCKET_COUNT] = {};
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> sum_ns_{0};
+    std::atomic<uint64_t> max_ns_{0};
+};
+
+// ============================================================================
+// HistogramRegistry - Named stages, SIGUSR1 dump
+// ============================================================================
+
+class HistogramRegistry {
+public:
+    static constexpr int MAX_STAGES = 16;
+
+    static HistogramRegistry& instance() {
+        static HistogramRegistry registry;
+        return registry;
+    }
+
+    // Find or create a stage histogram; callers cache the pointer so the
+    // hot path never re-resolves the name
+    LatencyHistogram* stage(const char* name) {
+        int n = slot_count_.load(std::memory_order_acquire);
+        for (int i = 0; i < n; i++) {
+            if (strcmp(slots_[i].name, name) == 0) {
+                return &slots_[i].hist;
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(register_mutex_);
+        n = slot_count_.load(std::memory_order_relaxed);
+        for (int i = 0; i < n; i++) {
+            if (strcmp(slots_[i].name, name) == 0) {
+                return &slots_[i].hist;
+            }
+        }
+        if (n >= MAX_STAGES) {
+            return &overflow_;  // Shared sink rather than nullptr checks
+        }
+        slots_[n].name = name;
+        slot_count_.store(n + 1, std::memory_order_release);
+        return &slots_[n].hist;
+    }
+
+    // Dump all stages to fd (snprintf + write only: callable from the
+    // SIGUSR1 handler while the stream keeps running)
+    void dump(int fd) const {
+        char line[160];
+        int len = snprintf(line, sizeof(line),
+                           "%-14s %10s %9s %9s %9s %9s %9s %9s\n",
+                           "stage (us)", "count", "mean", "p50", "p95",
+                           "p99", "p99.9", "max");
+        (void)!write(fd, line, len);
+
+        int n = slot_count_.load(std::memory_order_acquire);
+        for (int i = 0; i < n; i++) {
+            const LatencyHistogram& h = slots_[i].hist;
+            len = snprintf(line, sizeof(line),
+                           "%-14s %10llu %9.1f %9.1f %9.1f %9.1f %9.1f %9.1f\n",
+                           slots_[i].name,
+                           (unsigned long long)h.count(), h.mean_us(),
+                           h.percentile_us(0.50), h.percentile_us(0.95),
+                           h.percentile_us(0.99), h.percentile_us(0.999),
+                           h.max_us());
+            (void)!write(fd, line, len);
+        }
+    }
+
+    // Visit all registered stages (read-only; used by the telemetry
+    // JSON snapshot, which formats percentiles outside the hot path)
+    template <typename Fn>
+    void for_each(Fn fn) const {
+        int n = slot_count_.load(std::memory_order_acquire);
+        for (int i = 0; i < n; i++) {
+            fn(slots_[i].name, slots_[i].hist);
+        }
+    }
+
+    void reset_all() {
+        int n = slot_count_.load(std::memory_order_acquire);
+        for (int i = 0; i < n; i++) {
+            slots_[i].hist.reset();
+        }
+    }
+
+private:
+    HistogramRegistry() = default;
+
+    struct Slot {
+        const char* name = nullptr;
+        LatencyHistogram hist;
+    };
+
+    Slot slots_[MAX_STAGES];
+    LatencyHistogram overflow_;
+    std::atomic<int> slot_count_{0};
+    std::mutex register_mutex_;
+};
+
+// Stage lookup shorthand (cache the result in a static local)
+inline LatencyHistogram* stage(const char* name) {
+    return HistogramRegistry::instance().stage(name);
+}
+
+// ============================================================================
+// SIGUSR1 live dump
+// ============================================================================
+
+extern "C" inline void latency_sigusr1_handler(int) {
+    HistogramRegistry::instance().dump(STDERR_FILENO);
+}
+
+// Install a SIGUSR1 handler that dumps all stage histograms to stderr.
+// kill -USR1 <pid> prints a snapshot without interrupting the stream.
+inline void install_sigusr1_dump() {
+    HistogramRegistry::instance();  // Construct before any signal arrives
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = latency_sigusr1_handler;
+    sigemptyset(&sa.sa_mask);
+    sa.sa_flags = SA_RESTART;
+    sigaction(SIGUSR1, &sa, nullptr);
+}
+
+} // namespace latency
+
+#endif // LATENCY_HISTOGRAM_HPP
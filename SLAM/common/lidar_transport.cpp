@@ -0,0 +1,441 @@
+#include "lidar_transport.hpp"
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <errno.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+
+// SIMD intrinsics for the point filter kernel (selected via CMakeLists.txt)
+#ifdef HAVE_ARM_NEON
+#include <arm_neon.h>
+#endif
+#ifdef HAVE_X86_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace lidar_transport {
+
+// ============================================
+// Point Filter/Convert Kernel
+// ============================================
+//
+// This is the hottest loop in the sender (~452k pts/s from the Mid-360),
+// so a SIMD kernel (NEON on aarch64, SSE2 on x86_64) processes 4 points
+// per iteration; the scalar path remains as reference and tail handler.
+// Selection (modulo downsample or the caller's keep callback) runs in the
+// scalar lane-pack step, after the vectorized convert + range gate.
+
+/**
+ * Scalar filter/convert path (reference implementation and SIMD tail)
+ *
+ * @param start_idx Index of raw[0] within the callback (downsample phase)
+ */
+static void filter_convert_scalar(const LivoxLidarCartesianHighRawPoint* raw, int n,
+                                  int start_idx, Point3D* out, int* out_count,
+                                  int max_out, const FilterParams& params,
+                                  uint64_t* rejected_total, int* skipped_overflow) {
+    float min2 = params.min_range * params.min_range;
+    float max2 = params.max_range * params.max_range;
+    uint64_t rejected = 0;
+
+    for (int i = 0; i < n; i++) {
+        // Check buffer overflow (should never happen with a 2048 buffer)
+        if (*out_count >= max_out) {
+            (*skipped_overflow)++;
+            continue;
+        }
+
+        // Skip invalid (0,0,0) points
+        if (raw[i].x == 0 && raw[i].y == 0 && raw[i].z == 0) {
+            rejected++;
+            continue;
+        }
+
+        // Convert mm to meters
+        float x = raw[i].x / 1000.0f;
+        float y = raw[i].y / 1000.0f;
+        float z = raw[i].z / 1000.0f;
+
+        // Distance gating
+        float d2 = x*x + y*y + z*z;
+        if (d2 < min2 || d2 > max2) {
+            rejected++;
+            continue;
+        }
+
+        // Height gating (z band / ground-plane rejection)
+        if (z < params.z_min || z > params.z_max) {
+            rejected++;
+            continue;
+        }
+
+        // Selection: caller's keep callback, or modulo downsampling
+        if (params.keep) {
+            if (!params.keep(params.keep_ctx, x, y, z, raw[i].reflectivity)) {
+                rejected++;
+                continue;
+            }
+        } else if (params.downsample > 1 &&
+                   ((start_idx + i) % params.downsample) != 0) {
+            rejected++;
+            continue;
+        }
+
+        // Add to buffer
+        out[*out_count].x = x;
+        out[*out_count].y = y;
+        out[*out_count].z = z;
+        out[*out_count].intensity = raw[i].reflectivity;
+        (*out_count)++;
+    }
+
+    *rejected_total += rejected;
+}
+
+#ifdef HAVE_ARM_NEON
+/**
+ * NEON filter/convert path: 4 points per iteration
+ *
+ * Convert and range-gate happen in SIMD lanes; surviving lanes are packed
+ * into the (13-byte packed) Point3D output scalar-wise.
+ */
+static void filter_convert_simd(const LivoxLidarCartesianHighRawPoint* raw, int n,
+                                Point3D* out, int* out_count,
+                                int max_out, const FilterParams& params,
+                                uint64_t* rejected_total, int* skipped_overflow) {
+    const float32x4_t scale = vdupq_n_f32(0.001f);
+    const float32x4_t vmin2 = vdupq_n_f32(params.min_range * params.min_range);
+    const float32x4_t vmax2 = vdupq_n_f32(params.max_range * params.max_range);
+    const float32x4_t vzmin = vdupq_n_f32(params.z_min);
+    const float32x4_t vzmax = vdupq_n_f32(params.z_max);
+    const int32x4_t vzero = vdupq_n_s32(0);
+    uint64_t rejected = 0;
+
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        // Gather lanes (raw points are packed structs, no contiguous load)
+        int32_t xa[4] = { raw[i].x, raw[i+1].x, raw[i+2].x, raw[i+3].x };
+        int32_t ya[4] = { raw[i].y, raw[i+1].y, raw[i+2].y, raw[i+3].y };
+        int32_t za[4] = { raw[i].z, raw[i+1].z, raw[i+2].z, raw[i+3].z };
+        int32x4_t xi = vld1q_s32(xa);
+        int32x4_t yi = vld1q_s32(ya);
+        int32x4_t zi = vld1q_s32(za);
+
+        // mm -> m (multiply by reciprocal, no division)
+        float32x4_t x = vmulq_f32(vcvtq_f32_s32(xi), scale);
+        float32x4_t y = vmulq_f32(vcvtq_f32_s32(yi), scale);
+        float32x4_t z = vmulq_f32(vcvtq_f32_s32(zi), scale);
+
+        // Squared distance + range gate
+        float32x4_t d2 = vmlaq_f32(vmlaq_f32(vmulq_f32(x, x), y, y), z, z);
+        uint32x4_t in_range = vandq_u32(vcgeq_f32(d2, vmin2), vcleq_f32(d2, vmax2));
+
+        // Height gate (z band) folded into the same mask
+        in_range = vandq_u32(in_range, vandq_u32(vcgeq_f32(z, vzmin),
+                                                 vcleq_f32(z, vzmax)));
+
+        // Invalid (0,0,0) points (checked in the integer domain)
+        uint32x4_t is_zero = vandq_u32(vandq_u32(vceqq_s32(xi, vzero),
+                                                 vceqq_s32(yi, vzero)),
+                                       vceqq_s32(zi, vzero));
+        uint32x4_t keep = vbicq_u32(in_range, is_zero);
+
+        uint32_t keep_lanes[4];
+        float xs[4], ys[4], zs[4];
+        vst1q_u32(keep_lanes, keep);
+        vst1q_f32(xs, x);
+        vst1q_f32(ys, y);
+        vst1q_f32(zs, z);
+
+        // Pack surviving lanes
+        for (int lane = 0; lane < 4; lane++) {
+            if (*out_count >= max_out) {
+                (*skipped_overflow)++;
+                continue;
+            }
+            if (!keep_lanes[lane]) {
+                rejected++;
+                continue;
+            }
+            if (params.keep) {
+                if (!params.keep(params.keep_ctx, xs[lane], ys[lane], zs[lane],
+                                 raw[i + lane].reflectivity)) {
+                    rejected++;
+                    continue;
+                }
+            } else if (params.downsample > 1 &&
+                       ((i + lane) % params.downsample) != 0) {
+                rejected++;
+                continue;
+            }
+            out[*out_count].x = xs[lane];
+            out[*out_count].y = ys[lane];
+            out[*out_count].z = zs[lane];
+            out[*out_count].intensity = raw[i + lane].reflectivity;
+            (*out_count)++;
+        }
+    }
+
+    *rejected_total += rejected;
+
+    // Scalar tail (n % 4 points)
+    if (i < n) {
+        filter_convert_scalar(raw + i, n - i, i, out, out_count, max_out,
+                              params, rejected_total, skipped_overflow);
+    }
+}
+#endif  // HAVE_ARM_NEON
+
+#ifdef HAVE_X86_SSE2
+/**
+ * SSE2 filter/convert path: 4 points per iteration
+ *
+ * Convert and range-gate happen in SIMD lanes; surviving lanes are packed
+ * into the (13-byte packed) Point3D output scalar-wise.
+ */
+static void filter_convert_simd(const LivoxLidarCartesianHighRawPoint* raw, int n,
+                                Point3D* out, int* out_count,
+                                int max_out, const FilterParams& params,
+                                uint64_t* rejected_total, int* skipped_overflow) {
+    const __m128 scale = _mm_set1_ps(0.001f);
+    const __m128 vmin2 = _mm_set1_ps(params.min_range * params.min_range);
+    const __m128 vmax2 = _mm_set1_ps(params.max_range * params.max_range);
+    const __m128 vzmin = _mm_set1_ps(params.z_min);
+    const __m128 vzmax = _mm_set1_ps(params.z_max);
+    const __m128i vzero = _mm_setzero_si128();
+    uint64_t rejected = 0;
+
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        // Gather lanes (raw points are packed structs, no contiguous load)
+        __m128i xi = _mm_set_epi32(raw[i+3].x, raw[i+2].x, raw[i+1].x, raw[i].x);
+        __m128i yi = _mm_set_epi32(raw[i+3].y, raw[i+2].y, raw[i+1].y, raw[i].y);
+        __m128i zi = _mm_set_epi32(raw[i+3].z, raw[i+2].z, raw[i+1].z, raw[i].z);
+
+        // mm -> m (multiply by reciprocal, no division)
+        __m128 x = _mm_mul_ps(_mm_cvtepi32_ps(xi), scale);
+        __m128 y = _mm_mul_ps(_mm_cvtepi32_ps(yi), scale);
+        __m128 z = _mm_mul_ps(_mm_cvtepi32_ps(zi), scale);
+
+        // Squared distance + range gate
+        __m128 d2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)),
+                               _mm_mul_ps(z, z));
+        __m128 in_range = _mm_and_ps(_mm_cmpge_ps(d2, vmin2), _mm_cmple_ps(d2, vmax2));
+
+        // Height gate (z band) folded into the same mask
+        in_range = _mm_and_ps(in_range, _mm_and_ps(_mm_cmpge_ps(z, vzmin),
+                                                   _mm_cmple_ps(z, vzmax)));
+
+        // Invalid (0,0,0) points (checked in the integer domain)
+        __m128i is_zero = _mm_and_si128(_mm_and_si128(_mm_cmpeq_epi32(xi, vzero),
+                                                      _mm_cmpeq_epi32(yi, vzero)),
+                                        _mm_cmpeq_epi32(zi, vzero));
+
+        int keep_mask = _mm_movemask_ps(in_range) &
+                        ~_mm_movemask_ps(_mm_castsi128_ps(is_zero));
+
+        float xs[4], ys[4], zs[4];
+        _mm_storeu_ps(xs, x);
+        _mm_storeu_ps(ys, y);
+        _mm_storeu_ps(zs, z);
+
+        // Pack surviving lanes
+        for (int lane = 0; lane < 4; lane++) {
+            if (*out_count >= max_out) {
+                (*skipped_overflow)++;
+                continue;
+            }
+            if (!((keep_mask >> lane) & 1)) {
+                rejected++;
+                continue;
+            }
+            if (params.keep) {
+                if (!params.keep(params.keep_ctx, xs[lane], ys[lane], zs[lane],
+                                 raw[i + lane].reflectivity)) {
+                    rejected++;
+                    continue;
+                }
+            } else if (params.downsample > 1 &&
+                       ((i + lane) % params.downsample) != 0) {
+                rejected++;
+                continue;
+            }
+            out[*out_count].x = xs[lane];
+            out[*out_count].y = ys[lane];
+            out[*out_count].z = zs[lane];
+            out[*out_count].intensity = raw[i + lane].reflectivity;
+            (*out_count)++;
+        }
+    }
+
+    *rejected_total += rejected;
+
+    // Scalar tail (n % 4 points)
+    if (i < n) {
+        filter_convert_scalar(raw + i, n - i, i, out, out_count, max_out,
+                              params, rejected_total, skipped_overflow);
+    }
+}
+#endif  // HAVE_X86_SSE2
+
+int filter_convert_points(const LivoxLidarCartesianHighRawPoint* raw, int n,
+                          Point3D* out, int max_out,
+                          const FilterParams& params,
+                          uint64_t* rejected, int* skipped_overflow) {
+    int out_count = 0;
+    uint64_t rejected_local = 0;
+    int overflow_local = 0;
+
+#if defined(HAVE_ARM_NEON) || defined(HAVE_X86_SSE2)
+    filter_convert_simd(raw, n, out, &out_count, max_out, params,
+                        &rejected_local, &overflow_local);
+#else
+    filter_convert_scalar(raw, n, 0, out, &out_count, max_out, params,
+                          &rejected_local, &overflow_local);
+#endif
+
+    if (rejected) *rejected = rejected_local;
+    if (skipped_overflow) *skipped_overflow = overflow_local;
+    return out_count;
+}
+
+// ============================================
+// Batched UDP Transmit
+// ============================================
+
+// sendmmsg batch cap per syscall; flush() chunks larger counts internally
+#define SENDER_MAX_BATCH 32
+
+UdpSender::~UdpSender() {
+    close();
+}
+
+bool UdpSender::open(const char* target_ip, int target_port,
+                     long snd_timeout_usec, int sndbuf_bytes) {
+    fd_ = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd_ < 0) {
+        perror("❌ Failed to create UDP socket");
+        return false;
+    }
+
+    if (snd_timeout_usec > 0) {
+        struct timeval timeout;
+        timeout.tv_sec = snd_timeout_usec / 1000000;
+        timeout.tv_usec = snd_timeout_usec % 1000000;
+        if (setsockopt(fd_, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout)) < 0) {
+            perror("⚠ WARNING: Failed to set SO_SNDTIMEO");
+        }
+    }
+
+    if (sndbuf_bytes > 0) {
+        if (setsockopt(fd_, SOL_SOCKET, SO_SNDBUF, &sndbuf_bytes,
+                       sizeof(sndbuf_bytes)) < 0) {
+            perror("⚠ WARNING: Failed to set SO_SNDBUF");
+        }
+    }
+
+    memset(&target_, 0, sizeof(target_));
+    target_.sin_family = AF_INET;
+    target_.sin_port = htons((uint16_t)target_port);
+    if (inet_pton(AF_INET, target_ip, &target_.sin_addr) <= 0) {
+        fprintf(stderr, "❌ Invalid target IP: %s\n", target_ip);
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+void UdpSender::close() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+/**
+ * sendto() loop fallback for kernels without sendmmsg()
+ *
+ * @return Datagrams sent before stopping (EAGAIN or error)
+ */
+static int flush_sendto_loop(int fd, const struct sockaddr_in* target,
+                             const struct iovec* iov, int count,
+                             UdpSender::FlushResult* res) {
+    for (int i = 0; i < count; i++) {
+        ssize_t sent = sendto(fd, iov[i].iov_base, iov[i].iov_len, 0,
+                              (const struct sockaddr*)target, sizeof(*target));
+        if (sent < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                res->eagain = true;
+                return res->sent;
+            }
+            perror("sendto failed");
+            return -1;
+        }
+        res->sent++;
+        res->bytes += (size_t)sent;
+    }
+    return res->sent;
+}
+
+int UdpSender::flush(const struct iovec* iov, int count, FlushResult* res) {
+    *res = FlushResult();
+
+    if (count <= 0 || fd_ < 0) {
+        return 0;
+    }
+
+    if (sendmmsg_unavailable_) {
+        return flush_sendto_loop(fd_, &target_, iov, count, res);
+    }
+
+    // Per-batch message headers (stack: SENDER_MAX_BATCH * ~56 bytes)
+    struct mmsghdr msgs[SENDER_MAX_BATCH];
+
+    int offset = 0;
+    while (offset < count) {
+        int batch = count - offset;
+        if (batch > SENDER_MAX_BATCH) batch = SENDER_MAX_BATCH;
+
+        for (int i = 0; i < batch; i++) {
+            memset(&msgs[i].msg_hdr, 0, sizeof(struct msghdr));
+            msgs[i].msg_hdr.msg_name = &target_;
+            msgs[i].msg_hdr.msg_namelen = sizeof(target_);
+            // iovecs are caller-owned and const for us; sendmmsg does not
+            // modify them, the API just lacks the qualifier
+            msgs[i].msg_hdr.msg_iov = (struct iovec*)&iov[offset + i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+            msgs[i].msg_len = 0;
+        }
+
+        int sent = sendmmsg(fd_, msgs, batch, 0);
+
+        if (sent < 0) {
+            if (errno == ENOSYS || errno == ENOTSUP) {
+                // Kernel lacks sendmmsg: switch to per-packet loop permanently
+                fprintf(stderr, "⚠ sendmmsg not supported, falling back to sendto loop\n");
+                sendmmsg_unavailable_ = true;
+                return flush_sendto_loop(fd_, &target_, iov + offset,
+                                         count - offset, res);
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                res->eagain = true;
+                return res->sent;
+            }
+            perror("sendmmsg failed");
+            return -1;
+        }
+
+        for (int i = 0; i < sent; i++) {
+            res->bytes += iov[offset + i].iov_len;
+        }
+        res->sent += sent;
+        offset += sent;
+    }
+
+    return res->sent;
+}
+
+} // namespace lidar_transport
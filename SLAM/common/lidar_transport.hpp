@@ -0,0 +1,167 @@
+#ifndef LIDAR_TRANSPORT_HPP
+#define LIDAR_TRANSPORT_HPP
+
+#include "livox_lidar_def.h"
+#include <stdint.h>
+#include <stddef.h>
+#include <math.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <netinet/in.h>
+
+// Shared LiDAR transport kernels (SLAM/common)
+//
+// The filter/convert kernel and the batched UDP transmit path used to live
+// only in SLAM/lidar_tx/lidar_stream.cpp; the viewer stream target
+// (LiDAR/g1_lidar_stream.cpp) carried an independent, slower copy of both.
+// This static library is the single implementation both binaries link:
+//  - filter_convert_points(): mm->m convert + range gate + selection,
+//    SIMD (NEON/SSE2) when built with the matching HAVE_* definition
+//  - UdpSender: socket setup + sendmmsg-batched datagram flush with
+//    sendto() fallback on kernels without sendmmsg()
+//
+// The library is wire-format agnostic: callers build their own datagrams
+// (LIVR packets in lidar_tx, headerless point runs in the viewer stream)
+// and hand pre-built iovecs to UdpSender::flush().
+
+namespace lidar_transport {
+
+// ============================================
+// Point Filter/Convert Kernel
+// ============================================
+
+/**
+ * Point3D (13 bytes, little-endian, packed)
+ *
+ * The on-wire point layout shared by the LIVR v1 payload and the viewer
+ * stream's headerless datagrams.
+ */
+struct __attribute__((packed)) Point3D {
+    float x;                     // X coordinate (meters)
+    float y;                     // Y coordinate (meters)
+    float z;                     // Z coordinate (meters)
+    uint8_t intensity;           // Reflectivity (0-255)
+};
+
+static_assert(sizeof(Point3D) == 13, "Point3D must be exactly 13 bytes");
+
+/**
+ * Optional per-point selector, invoked after the range gate
+ *
+ * Return false to reject the point. Used by the SLAM sender's budgeted
+ * selection mode; when set it replaces the modulo downsample.
+ */
+typedef bool (*KeepFn)(void* ctx, float x, float y, float z, uint8_t intensity);
+
+/**
+ * Filter kernel parameters (read once per call, no globals)
+ *
+ * z_min/z_max gate on sensor-frame height the same way min/max_range gate
+ * on distance (used for ground-plane rejection: a sensor mounted h meters
+ * above the floor sees floor returns near z = -h). The infinite defaults
+ * keep the band wide open for callers that do not set it.
+ */
+struct FilterParams {
+    float min_range;             // Reject points closer than this (meters)
+    float max_range;             // Reject points farther than this (meters)
+    float z_min = -INFINITY;     // Reject points below this height (meters)
+    float z_max = INFINITY;      // Reject points above this height (meters)
+    int downsample;              // Keep every Nth raw index (<= 1 keeps all)
+    KeepFn keep;                 // Optional selector (overrides downsample)
+    void* keep_ctx;              // Opaque context passed to keep
+};
+
+/**
+ * Filter and convert one callback's raw points into a Point3D buffer
+ *
+ * Converts raw Livox points (int32 millimeters) to Point3D (float meters),
+ * rejecting invalid (0,0,0) points, out-of-range points, points outside
+ * the z band, and deselected points. Dispatches to the SIMD kernel (4
+ * points/iteration) when built
+ * with HAVE_ARM_NEON or HAVE_X86_SSE2, otherwise runs the scalar path.
+ *
+ * @param raw Raw Livox points (millimeters)
+ * @param n Number of raw points
+ * @param out Output buffer
+ * @param max_out Output buffer capacity
+ * @param params Range gate + selection parameters
+ * @param rejected Out: points rejected (invalid/range/selection), may be NULL
+ * @param skipped_overflow Out: points skipped due to full output, may be NULL
+ * @return Number of points written to out
+ */
+int filter_convert_points(const LivoxLidarCartesianHighRawPoint* raw, int n,
+                          Point3D* out, int max_out,
+                          const FilterParams& params,
+                          uint64_t* rejected, int* skipped_overflow);
+
+// ============================================
+// Batched UDP Transmit
+// ============================================
+
+/**
+ * UDP sender with sendmmsg-batched flush
+ *
+ * Owns the socket (non-blocking-ish via SO_SNDTIMEO) and the target
+ * address. flush() submits pre-built datagrams with one sendmmsg()
+ * syscall per batch and degrades permanently to a sendto() loop on
+ * kernels without sendmmsg() (pre-3.0, ENOSYS).
+ */
+class UdpSender {
+public:
+    UdpSender() = default;
+    ~UdpSender();
+
+    // Non-copyable (owns the fd)
+    UdpSender(const UdpSender&) = delete;
+    UdpSender& operator=(const UdpSender&) = delete;
+
+    /**
+     * Create and configure the socket
+     *
+     * @param target_ip Destination IPv4 address (dotted quad)
+     * @param target_port Destination UDP port
+     * @param snd_timeout_usec SO_SNDTIMEO in microseconds (0 = none)
+     * @param sndbuf_bytes SO_SNDBUF request (0 = kernel default)
+     * @return true on success (invalid IP or socket failure returns false)
+     */
+    bool open(const char* target_ip, int target_port,
+              long snd_timeout_usec, int sndbuf_bytes);
+
+    void close();
+
+    bool is_open() const { return fd_ >= 0; }
+    int fd() const { return fd_; }
+
+    /**
+     * Flush result: what the kernel accepted and why we stopped
+     */
+    struct FlushResult {
+        int sent = 0;            // Datagrams accepted by the kernel
+        size_t bytes = 0;        // Wire bytes accepted
+        bool eagain = false;     // Stopped early: socket buffer full
+    };
+
+    /**
+     * Send pre-built datagrams (one iovec each) in sendmmsg batches
+     *
+     * Retries partial sends until all datagrams are submitted or the
+     * socket buffer fills (EAGAIN). The unsent tail on EAGAIN is the
+     * caller's to account for and drop. Per-datagram accounting (bytes,
+     * point counts) stays with the caller via res->sent.
+     *
+     * @return Number of datagrams sent (== res->sent), -1 on hard error
+     */
+    int flush(const struct iovec* iov, int count, FlushResult* res);
+
+    // True once the kernel reported ENOSYS for sendmmsg (fallback active)
+    bool sendmmsg_unavailable() const { return sendmmsg_unavailable_; }
+
+private:
+    int fd_ = -1;
+    struct sockaddr_in target_ = {};
+    bool sendmmsg_unavailable_ = false;
+};
+
+} // namespace lidar_transport
+
+#endif // LIDAR_TRANSPORT_HPP
@@ -0,0 +1,193 @@
+#ifndef TELEMETRY_HPP
+#define TELEMETRY_HPP
+
+#include <atomic>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <thread>
+
+#include <errno.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#include "latency_histogram.hpp"
+
+// Telemetry - on-demand JSON counter export over UDP
+//
+// Fleet monitoring used to scrape the periodic stdout lines with regexes.
+// Instead, both the sender (lidar_tx) and the native rx module bind a
+// small UDP endpoint: any datagram sent to it (e.g. `echo | nc -u host
+// port`) gets one JSON snapshot back. The snapshot callback reads the
+// process's atomic counters with relaxed loads and formats the registered
+// latency histograms - nothing on the packet hot path is touched, and no
+// sample is taken unless a scraper actually asks.
+//
+// The server thread blocks in recvfrom() with a 200ms SO_RCVTIMEO so
+// stop() joins promptly; replies are built in a fixed buffer (no
+// allocation) and sent to whoever asked.
+
+namespace telemetry {
+
+// ============================================================================
+// Bounded snprintf append
+// ============================================================================
+
+// Append formatted text at offset `off`, clamped to cap. Returns the new
+// offset (== cap once truncated; further appends are no-ops).
+inline size_t append(char* buf, size_t cap, size_t off, const char* fmt, ...)
+    __attribute__((format(printf, 4, 5)));
+
+inline size_t append(char* buf, size_t cap, size_t off, const char* fmt, ...) {
+    if (off >= cap) {
+        return cap;
+    }
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vsnprintf(buf + off, cap - off, fmt, ap);
+    va_end(ap);
+    if (n < 0) {
+        return off;
+    }
+    return (off + (size_t)n > cap) ? cap : off + (size_t)n;
+}
+
+// ============================================================================
+// Latency histogram JSON
+// ============================================================================
+
+// Append all registered stage histograms as one JSON object:
+//   "latency_us":{"filter":{"count":N,"mean":..,"p50":..,...},...}
+inline size_t histograms_json(char* buf, size_t cap, size_t off) {
+    off = append(buf, cap, off, "\"latency_us\":{");
+
+    bool first = true;
+    latency::HistogramRegistry::instance().for_each(
+        [&](const char* name, const latency::LatencyHistogram& h) {
+            off = append(buf, cap, off,
+                         "%s\"%s\":{\"count\":%llu,\"mean\":%.1f,\"p50\":%.1f,"
+                         "\"p95\":%.1f,\"p99\":%.1f,\"p999\":%.1f,\"max\":%.1f}",
+                         first ? "" : ",", name,
+                         (unsigned long long)h.count(), h.mean_us(),
+                         h.percentile_us(0.50), h.percentile_us(0.95),
+                         h.percentile_us(0.99), h.percentile_us(0.999),
+                         h.max_us());
+            first = false;
+        });
+
+    return append(buf, cap, off, "}");
+}
+
+// ============================================================================
+// TelemetryServer - UDP request/reply snapshot endpoint
+// ============================================================================
+
+class TelemetryServer {
+public:
+    // Snapshot callback: fill buf with a JSON document, return its length
+    using SnapshotFn = std::function<size_t(char* buf, size_t cap)>;
+
+    TelemetryServer() = default;
+    ~TelemetryServer() { stop(); }
+
+    TelemetryServer(const TelemetryServer&) = delete;
+    TelemetryServer& operator=(const TelemetryServer&) = delete;
+
+    // Bind the endpoint and start the reply thread (false on bind failure)
+    bool start(uint16_t port, SnapshotFn snapshot) {
+        if (running_.load(std::memory_order_relaxed)) {
+            return false;
+        }
+
+        fd_ = socket(AF_INET, SOCK_DGRAM, 0);
+        if (fd_ < 0) {
+            perror("⚠ telemetry: socket failed");
+            return false;
+        }
+
+        int reuse = 1;
+        setsockopt(fd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+        // 200ms receive timeout: the loop wakes to check the stop flag
+        struct timeval tv;
+        tv.tv_sec = 0;
+        tv.tv_usec = 200000;
+        setsockopt(fd_, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+        struct sockaddr_in addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_ANY);
+        addr.sin_port = htons(port);
+        if (bind(fd_, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+            perror("⚠ telemetry: bind failed");
+            ::close(fd_);
+            fd_ = -1;
+            return false;
+        }
+
+        snapshot_ = std::move(snapshot);
+        running_.store(true, std::memory_order_relaxed);
+        thread_ = std::thread(&TelemetryServer::serve_loop, this);
+        return true;
+    }
+
+    void stop() {
+        if (!running_.load(std::memory_order_relaxed)) {
+            return;
+        }
+        running_.store(false, std::memory_order_relaxed);
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    bool is_running() const { return running_.load(std::memory_order_relaxed); }
+
+private:
+    void serve_loop() {
+        // One outstanding reply at a time: single buffer, no allocation
+        static_assert(REPLY_CAP >= 4096, "reply buffer too small");
+
+        while (running_.load(std::memory_order_relaxed)) {
+            char req[64];
+            struct sockaddr_in peer;
+            socklen_t peer_len = sizeof(peer);
+
+            ssize_t n = recvfrom(fd_, req, sizeof(req), 0,
+                                 (struct sockaddr*)&peer, &peer_len);
+            if (n < 0) {
+                if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+                    continue;  // Timeout: re-check stop flag
+                }
+                break;
+            }
+
+            size_t len = snapshot_(reply_, REPLY_CAP);
+            if (len > 0) {
+                sendto(fd_, reply_, len, 0,
+                       (struct sockaddr*)&peer, peer_len);
+            }
+        }
+    }
+
+    static constexpr size_t REPLY_CAP = 32768;
+
+    int fd_ = -1;
+    std::atomic<bool> running_{false};
+    std::thread thread_;
+    SnapshotFn snapshot_;
+    char reply_[REPLY_CAP];
+};
+
+} // namespace telemetry
+
+#endif // TELEMETRY_HPP
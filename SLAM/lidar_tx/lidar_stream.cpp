@@ -34,6 +34,30 @@
 #include <math.h>
 #include <errno.h>
 #include <atomic>
+#include <new>
+#include <thread>
+
+// Shared transport library (SLAM/common): SIMD filter/convert kernel and
+// sendmmsg-batched UDP transmit, also linked by the viewer stream target
+#include "lidar_transport.hpp"
+
+// Shared log-bucketed latency histograms (SLAM/common); kill -USR1 dumps
+// live per-stage percentiles without stopping the stream
+#include "latency_histogram.hpp"
+
+// On-demand JSON counter export over UDP (SLAM/common); any datagram to
+// the telemetry port gets one snapshot back, nothing touches the hot path
+#include "telemetry.hpp"
+
+// ARMv8 CRC32 extension (IEEE 802.3 polynomial in hardware)
+#ifdef HAVE_ARM_CRC32
+#include <arm_acle.h>
+#endif
+
+// Optional LZ4 payload compression (detected via CMakeLists.txt)
+#ifdef HAVE_LZ4
+#include <lz4.h>
+#endif
 
 // ============================================
 // Configuration
@@ -49,9 +73,43 @@
 #define POINT_SIZE 13              // Point3D size (x,y,z float + intensity uint8)
 #define MAX_POINTS_PER_PACKET ((MAX_UDP_PAYLOAD - HEADER_SIZE) / POINT_SIZE)  // 105 points
 
+// Protocol v2: quantized 16-bit points (selected per-packet via flags bit 0)
+#define FLAG_QUANT_POINTS 0x0001   // Header flags bit: payload is QuantBlock + QuantPoint3D[]
+#define QUANT_BLOCK_SIZE 16        // Per-packet offset[3] + scale (4 floats)
+#define QUANT_POINT_SIZE 7         // QuantPoint3D size (x,y,z int16 + intensity uint8)
+#define MAX_QUANT_POINTS_PER_PACKET \
+    ((MAX_UDP_PAYLOAD - HEADER_SIZE - QUANT_BLOCK_SIZE) / QUANT_POINT_SIZE)  // 193 points
+
+// Optional payload compression (selected per-packet via flags bit 1)
+#define FLAG_COMPRESSED_LZ4 0x0002 // Header flags bit: point payload is LZ4-compressed
+#define COMPRESS_ACCELERATION 2    // LZ4 fast mode (higher = faster, worse ratio)
+
+// Optional XOR parity FEC (selected per-packet via flags bit 2)
+#define FLAG_FEC_PARITY 0x0004     // Header flags bit: payload is FecBlock + XOR bytes
+#define FEC_BLOCK_SIZE 8           // FecBlock size
+#define FEC_MAX_K 16               // Max data packets per parity group
+#define FEC_MAX_QUANT_POINTS_PER_PACKET \
+    ((MAX_UDP_PAYLOAD - HEADER_SIZE - FEC_BLOCK_SIZE - QUANT_BLOCK_SIZE) / QUANT_POINT_SIZE)  // 192 points
+
+// Latency probe (selected per-packet via flags bit 3): host send time
+// appended as an 8-byte trailer; the receiver echoes a sample back
+#define FLAG_HOST_TS 0x0008        // Header flags bit: 8B host-ts trailer follows payload
+#define HOST_TS_TRAILER_SIZE 8     // uint64 CLOCK_MONOTONIC nanoseconds
+#define ECHO_MAGIC 0x4C495645      // "LIVE": latency echo from the receiver
+
+// Batched transmit (sendmmsg)
+#define MAX_SEGMENTS_PER_FLUSH 32  // Max packets per sendmmsg flush (2048 pts / 105 = 20, with headroom)
+
+// Transmit pipeline
+#define MAX_FILTERED_POINTS 2048   // Max filtered points per callback
+#define TX_RING_SIZE 64            // SPSC ring slots (must be power of two)
+#define TX_RING_MASK (TX_RING_SIZE - 1)
+#define TX_IDLE_SLEEP_USEC 200     // Sender thread sleep when ring is empty
+
 // Distance gating (meters) - defaults
 #define MIN_RANGE 0.1f
 #define MAX_RANGE 20.0f
+#define GROUND_TOLERANCE 0.10f  // Default --ground clearance above the floor
 #define DOWNSAMPLE_FACTOR 1
 
 // Network timeout
@@ -62,8 +120,14 @@
 #define LOG_INTERVAL_PACKETS 500
 #define STATS_WINDOW_SEC 1.0       // 1 second for rate calculation
 
-// Timestamp tracking
-#define TS_HISTORY_SIZE 100
+// Adaptive downsampling (closed-loop congestion response)
+#define ADAPT_WINDOW_NS 100000000ULL   // 100ms evaluation window
+#define ADAPT_MAX_MULTIPLIER 8         // Cap: configured factor x 8
+#define ADAPT_RECOVER_WINDOWS 5        // Clean windows before stepping back
+
+// Budgeted point selection (stratified over azimuth sectors)
+#define BUDGET_SECTORS 8               // Azimuth octants (sign/magnitude tests)
+#define BUDGET_CREDIT_CAP_NS 200000000ULL  // Max credit accrual: 200ms of budget
 
 // ============================================
 // Compile-time checks
@@ -94,21 +158,91 @@ static_assert(sizeof(PacketHeader) == 27, "PacketHeader must be exactly 27 bytes
 
 /**
  * Point3D (13 bytes, little-endian)
+ *
+ * Defined in the shared transport library; the LIVR v1 payload is an
+ * array of these.
+ */
+using Point3D = lidar_transport::Point3D;
+static_assert(sizeof(Point3D) == POINT_SIZE, "Point3D must be exactly 13 bytes");
+
+/**
+ * Quantization block (16 bytes, little-endian)
+ *
+ * Precedes the quantized point array in a v2 (FLAG_QUANT_POINTS) packet.
+ * Receiver reconstructs: coordinate = offset + q * scale.
+ */
+struct __attribute__((packed)) QuantBlock {
+    float offset_x;              // Per-axis midpoint of this packet (meters)
+    float offset_y;
+    float offset_z;
+    float scale;                 // Meters per LSB (uniform across axes)
+};
+
+static_assert(sizeof(QuantBlock) == QUANT_BLOCK_SIZE, "QuantBlock must be exactly 16 bytes");
+
+/**
+ * QuantPoint3D (7 bytes, little-endian)
+ *
+ * int16 coordinates relative to the packet's QuantBlock. At the Mid-360's
+ * ~40m span the worst-case resolution is ~1.2mm -- below sensor noise.
  */
-struct __attribute__((packed)) Point3D {
-    float x;                     // X coordinate (meters)
-    float y;                     // Y coordinate (meters)
-    float z;                     // Z coordinate (meters)
+struct __attribute__((packed)) QuantPoint3D {
+    int16_t x;                   // Quantized X: (x - offset_x) / scale
+    int16_t y;                   // Quantized Y
+    int16_t z;                   // Quantized Z
     uint8_t intensity;           // Reflectivity (0-255)
 };
 
+static_assert(sizeof(QuantPoint3D) == QUANT_POINT_SIZE, "QuantPoint3D must be exactly 7 bytes");
+
+/**
+ * FEC block (8 bytes, little-endian)
+ *
+ * Precedes the XOR bytes in a parity (FLAG_FEC_PARITY) packet. A parity
+ * packet protects the k data packets seq..seq+k-1: header.seq carries the
+ * first protected seq (parity does not consume a data seq),
+ * header.device_timestamp the XOR of the protected timestamps, and
+ * header.point_count the XOR byte length (the longest protected payload).
+ * The receiver can rebuild any single lost group member by XORing the
+ * parity payload with the members it did receive.
+ */
+struct __attribute__((packed)) FecBlock {
+    uint8_t  k;                  // Protected group size (2..FEC_MAX_K)
+    uint8_t  reserved;           // Zero
+    uint16_t xor_point_count;    // XOR of protected point_count fields
+    uint16_t xor_flags;          // XOR of protected flags fields
+    uint16_t xor_len;            // XOR of protected payload lengths (bytes)
+};
+
+static_assert(sizeof(FecBlock) == FEC_BLOCK_SIZE, "FecBlock must be exactly 8 bytes");
+
+/**
+ * Latency echo (24 bytes, little-endian)
+ *
+ * Returned by the receiver for a sampled FLAG_HOST_TS packet. RTT is the
+ * receipt time minus the echoed host_send_ns (both on this host's clock);
+ * rx_recv_ns is on the receiver's clock and, combined with the RTT's
+ * symmetric-path assumption, yields the tx/rx clock-offset estimate that
+ * turns later trailers into one-way latency measurements.
+ */
+struct __attribute__((packed)) EchoPacket {
+    uint32_t magic;              // ECHO_MAGIC
+    uint32_t seq;                // Sequence number of the sampled packet
+    uint64_t host_send_ns;       // Echoed from this sender's trailer
+    uint64_t rx_recv_ns;         // Receiver host time at receipt
+};
+
+static_assert(sizeof(EchoPacket) == 24, "EchoPacket must be exactly 24 bytes");
+
 // ============================================
 // Global State
 // ============================================
 
-// Network
-int udp_socket = -1;
-struct sockaddr_in target_addr;
+// Network (shared transport library owns the socket + target address)
+lidar_transport::UdpSender g_sender;
+
+// Telemetry endpoint (JSON snapshots on demand, see --telemetry-port)
+telemetry::TelemetryServer g_telemetry;
 
 // Sequence counter (atomic)
 std::atomic<uint32_t> packet_seq(0);
@@ -126,9 +260,141 @@ std::atomic<uint64_t> stats_send_eagain(0);
 std::atomic<uint32_t> stats_seq_wraps(0);
 std::atomic<uint64_t> stats_callback_count(0);
 
-// Timestamp tracking (for validation)
-uint64_t ts_history[TS_HISTORY_SIZE];
-int ts_history_idx = 0;
+// Heap allocations on the packet hot path (must stay 0 -- any code that has
+// to allocate while building/sending a packet increments this so perf
+// regressions are visible in the stats block)
+std::atomic<uint64_t> stats_packet_allocs(0);
+
+// True on the Livox callback and sender threads; the operator new override
+// below charges every allocation made while it is set to
+// stats_packet_allocs (same instrumentation as slam_rx_bench, but gated so
+// SDK-internal and startup allocations stay invisible)
+thread_local bool tl_on_packet_path = false;
+
+void* operator new(size_t size) {
+    if (tl_on_packet_path) {
+        stats_packet_allocs.fetch_add(1, std::memory_order_relaxed);
+    }
+    void* p = malloc(size);
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+// Per-stage latency histograms: tail events (not means) cause drops, so
+// the stats block and the SIGUSR1 dump report p50/p95/p99/p99.9/max
+latency::LatencyHistogram* const hist_filter = latency::stage("filter");
+latency::LatencyHistogram* const hist_sendmmsg = latency::stage("sendmmsg");
+latency::LatencyHistogram* const hist_ts_delta = latency::stage("ts_delta");
+latency::LatencyHistogram* const hist_echo_rtt = latency::stage("echo_rtt");
+
+// Latency probe: echo listener state. The best (minimum-RTT) sample gives
+// the NTP-style clock-offset estimate: queueing delay inflates RTT
+// symmetrically in expectation, so the smallest RTT is the cleanest path.
+std::atomic<uint64_t> stats_echoes_received(0);
+std::atomic<uint64_t> stats_echo_best_rtt_ns(UINT64_MAX);
+std::atomic<int64_t> stats_echo_offset_ns(0);   // rx clock - tx clock, at best RTT
+std::thread echo_thread;
+std::atomic<bool> echo_running(false);
+
+// Batched transmit statistics
+std::atomic<uint64_t> stats_flush_count(0);        // sendmmsg flushes issued
+std::atomic<uint64_t> stats_flush_segments(0);     // Packets sent via sendmmsg
+std::atomic<uint32_t> stats_flush_max_batch(0);    // Largest batch in a single flush
+
+// Compression statistics (budget: < 50us/packet on the Jetson)
+std::atomic<uint64_t> stats_compressed_packets(0);   // Packets sent compressed
+std::atomic<uint64_t> stats_compress_fallbacks(0);   // Incompressible: sent raw
+std::atomic<uint64_t> stats_compress_saved_bytes(0); // Wire bytes saved
+std::atomic<uint64_t> stats_compress_time_us(0);     // Time spent compressing
+
+// FEC statistics
+std::atomic<uint64_t> stats_fec_parity_packets(0);   // Parity packets emitted
+std::atomic<uint64_t> stats_fec_parity_bytes(0);     // Wire bytes spent on parity
+
+// Adaptive downsampling: the effective factor starts at the configured
+// g_downsample and is doubled/halved by adapt_update() in response to
+// send-side congestion. Written only on the callback thread, but atomic so
+// the stats printers can load it from other threads.
+std::atomic<int> g_adapt_factor(DOWNSAMPLE_FACTOR);
+
+// Adaptive controller window state (callback thread only)
+uint64_t adapt_window_start = 0;
+uint64_t adapt_last_congestion = 0;   // EAGAIN+overrun count at window start
+int adapt_clean_windows = 0;
+
+// Adaptive transition counters (for auditing controller behavior)
+std::atomic<uint64_t> stats_adapt_backoffs(0);    // Factor increases
+std::atomic<uint64_t> stats_adapt_recoveries(0);  // Factor decreases
+
+// Budgeted selection state (callback thread only). Credit accrues at
+// g_budget_pps and is spent by kept points, so unused budget from a sparse
+// callback carries over to the next one (capped at BUDGET_CREDIT_CAP_NS).
+double budget_credit = 0.0;            // Points available to spend
+uint64_t budget_last_ns = 0;           // Last credit accrual time
+int budget_callback_cap = 0;           // Total points allowed this callback
+int budget_sector_quota = 0;           // Per-sector allowance this callback
+int budget_total_kept = 0;             // Points kept this callback
+int budget_sector_kept[BUDGET_SECTORS]; // Per-sector kept counts
+uint64_t budget_rejected_cb = 0;       // Points rejected this callback
+
+// Budgeted selection statistics
+std::atomic<uint64_t> stats_budget_dropped(0);    // Points rejected by budget
+
+// Streaming statistics: Welford O(1) incremental mean/variance plus
+// min/max. Single writer (the callback thread); the stats printer
+// snapshots the atomics lock-free. A torn mean/M2 pair across one update
+// is possible on snapshot and harmless for reporting.
+struct StreamingStats {
+    std::atomic<uint64_t> count{0};
+    std::atomic<double> mean_ns{0.0};
+    std::atomic<double> m2_ns{0.0};     // Sum of squared deviations
+    std::atomic<uint64_t> min_ns{UINT64_MAX};
+    std::atomic<uint64_t> max_ns{0};
+
+    void update(uint64_t v) {
+        uint64_t n = count.load(std::memory_order_relaxed) + 1;
+        double mean = mean_ns.load(std::memory_order_relaxed);
+        double delta = (double)v - mean;
+        double new_mean = mean + delta / (double)n;
+        double m2 = m2_ns.load(std::memory_order_relaxed) +
+                    delta * ((double)v - new_mean);
+        mean_ns.store(new_mean, std::memory_order_relaxed);
+        m2_ns.store(m2, std::memory_order_relaxed);
+        count.store(n, std::memory_order_relaxed);
+
+        if (v < min_ns.load(std::memory_order_relaxed)) {
+            min_ns.store(v, std::memory_order_relaxed);
+        }
+        if (v > max_ns.load(std::memory_order_relaxed)) {
+            max_ns.store(v, std::memory_order_relaxed);
+        }
+    }
+
+    double mean_ms() const {
+        return mean_ns.load(std::memory_order_relaxed) / 1e6;
+    }
+    double stddev_ms() const {
+        uint64_t n = count.load(std::memory_order_relaxed);
+        if (n < 2) return 0.0;
+        return sqrt(m2_ns.load(std::memory_order_relaxed) / (double)n) / 1e6;
+    }
+    double min_ms() const {
+        uint64_t v = min_ns.load(std::memory_order_relaxed);
+        return (v == UINT64_MAX) ? 0.0 : v / 1e6;
+    }
+    double max_ms() const {
+        return max_ns.load(std::memory_order_relaxed) / 1e6;
+    }
+};
+
+// Timestamp tracking (for validation). Inter-callback delta statistics:
+// Welford accumulator for exact mean/stddev/min/max, plus the shared
+// log-bucketed histogram as the quantile sketch (~3% resolution) so
+// jitter percentiles are cheap enough to keep enabled in production.
+StreamingStats ts_delta_stats;
 uint64_t ts_last = 0;
 bool ts_using_fallback = false;
 bool ts_first_packet = true;
@@ -148,21 +414,45 @@ volatile sig_atomic_t keep_running = 1;
 // Config
 float g_min_range = MIN_RANGE;
 float g_max_range = MAX_RANGE;
+float g_z_min = -INFINITY;  // Height band floor (sensor frame; -inf = open)
+float g_z_max = INFINITY;   // Height band ceiling (+inf = open)
+float g_ground_height = 0.0f;   // Ground filter: sensor height (0 = off)
+float g_ground_tol = GROUND_TOLERANCE;
 int g_downsample = DOWNSAMPLE_FACTOR;
+bool g_adaptive = false;
+int g_budget_pps = 0;   // Target points/sec (0 = modulo downsample mode)
+int g_telemetry_port = 0;  // UDP telemetry endpoint (0 = disabled)
 bool g_crc_enabled = false;
+bool g_quantize = false;
+bool g_compress = false;
+int g_fec_k = 0;        // XOR parity group size (0 = FEC off)
 bool g_debug = false;
+bool g_fast_start = false;  // Defer banner I/O until streaming is up
+bool g_latency_probe = false;  // Host-ts trailer + echo listener (see --latency-probe)
+uint64_t g_exec_start_ns = 0;   // main() entry (exec-to-first-packet timing)
+
+// Handshake cache path (<config>.handshake; empty = disabled)
+char g_handshake_path[512] = {0};
 
 // ============================================
 // CRC32 IEEE 802.3
 // ============================================
 
 /**
- * CRC32 lookup table (IEEE 802.3 polynomial: 0x04C11DB7)
+ * CRC32 slice-by-8 lookup tables (IEEE 802.3 polynomial: 0x04C11DB7)
+ *
+ * Table [0] is the classic byte-at-a-time table; tables [1..7] extend it
+ * so the software path can consume 8 input bytes per iteration instead
+ * of one. Generated at compile time (C++14 constexpr), so process start
+ * pays no table build and the table cannot be wrong at runtime -- the
+ * boot-path self-test this replaces now only runs under --debug.
  */
-static uint32_t crc32_table[256];
-static bool crc32_table_initialized = false;
+struct Crc32Tables {
+    uint32_t t[8][256];
+};
 
-void crc32_init_table() {
+static constexpr Crc32Tables make_crc32_tables() {
+    Crc32Tables tables{};
     for (uint32_t i = 0; i < 256; i++) {
         uint32_t crc = i;
         for (int j = 0; j < 8; j++) {
@@ -172,29 +462,97 @@ void crc32_init_table() {
                 crc >>= 1;
             }
         }
-        crc32_table[i] = crc;
+        tables.t[0][i] = crc;
     }
-    crc32_table_initialized = true;
+
+    // Derive slice tables [1..7]
+    for (int t = 1; t < 8; t++) {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t crc = tables.t[t - 1][i];
+            tables.t[t][i] = (crc >> 8) ^ tables.t[0][crc & 0xFF];
+        }
+    }
+
+    return tables;
 }
 
+static constexpr Crc32Tables crc32_tables = make_crc32_tables();
+
 /**
- * Calculate CRC32 (IEEE 802.3)
+ * Incremental CRC32 update (IEEE 802.3, no initial/final XOR)
+ *
+ * Allows computing one CRC over discontiguous regions (e.g. header bytes
+ * [0..22] plus the payload after the CRC field) without staging them in a
+ * temporary buffer. Callers supply 0xFFFFFFFF as the initial value and
+ * XOR the result with 0xFFFFFFFF when done.
  *
+ * ARMv8 (Jetson): hardware CRC32 via the CRC extension (__crc32d computes
+ * the IEEE 802.3 polynomial directly, unlike SSE4.2 which is CRC-32C only).
+ * Other platforms: slice-by-8 software path, 8 bytes per iteration.
+ *
+ * @param crc Running CRC state
  * @param data Input data
  * @param length Data length
- * @return CRC32 checksum
+ * @return Updated CRC state
  */
-uint32_t crc32_calculate(const uint8_t* data, size_t length) {
-    if (!crc32_table_initialized) {
-        crc32_init_table();
+uint32_t crc32_update(uint32_t crc, const uint8_t* data, size_t length) {
+#ifdef HAVE_ARM_CRC32
+    size_t i = 0;
+
+    for (; i + 8 <= length; i += 8) {
+        uint64_t val;
+        memcpy(&val, data + i, 8);
+        crc = __crc32d(crc, val);
+    }
+    if (i + 4 <= length) {
+        uint32_t val;
+        memcpy(&val, data + i, 4);
+        crc = __crc32w(crc, val);
+        i += 4;
+    }
+    for (; i < length; i++) {
+        crc = __crc32b(crc, data[i]);
+    }
+
+    return crc;
+#else
+    size_t i = 0;
+
+    // Slice-by-8: 8 bytes per iteration (little-endian host, checked at startup)
+    for (; i + 8 <= length; i += 8) {
+        uint32_t lo, hi;
+        memcpy(&lo, data + i, 4);
+        memcpy(&hi, data + i + 4, 4);
+        lo ^= crc;
+        crc = crc32_tables.t[7][lo & 0xFF] ^
+              crc32_tables.t[6][(lo >> 8) & 0xFF] ^
+              crc32_tables.t[5][(lo >> 16) & 0xFF] ^
+              crc32_tables.t[4][lo >> 24] ^
+              crc32_tables.t[3][hi & 0xFF] ^
+              crc32_tables.t[2][(hi >> 8) & 0xFF] ^
+              crc32_tables.t[1][(hi >> 16) & 0xFF] ^
+              crc32_tables.t[0][hi >> 24];
     }
 
-    uint32_t crc = 0xFFFFFFFF;  // Initial value
-    for (size_t i = 0; i < length; i++) {
+    // Byte-at-a-time tail
+    for (; i < length; i++) {
         uint8_t index = (crc ^ data[i]) & 0xFF;
-        crc = (crc >> 8) ^ crc32_table[index];
+        crc = (crc >> 8) ^ crc32_tables.t[0][index];
     }
-    return crc ^ 0xFFFFFFFF;  // Final XOR
+
+    return crc;
+#endif
+}
+
+/**
+ * Calculate CRC32 (IEEE 802.3) over one contiguous buffer
+ *
+ * @param data Input data
+ * @param length Data length
+ * @return CRC32 checksum
+ */
+uint32_t crc32_calculate(const uint8_t* data, size_t length) {
+    return crc32_update(0xFFFFFFFF, data, length) ^ 0xFFFFFFFF;
 }
 
 /**
@@ -344,13 +702,13 @@ uint64_t extract_livox_timestamp(LivoxLidarEthernetPacket* data, uint64_t fallba
 }
 
 /**
- * Update timestamp statistics
+ * Update timestamp statistics (O(1): Welford + histogram insert)
  */
 void update_ts_stats(uint64_t ts) {
-    if (ts_last > 0) {
+    if (ts_last > 0 && ts > ts_last) {
         uint64_t delta = ts - ts_last;
-        ts_history[ts_history_idx] = delta;
-        ts_history_idx = (ts_history_idx + 1) % TS_HISTORY_SIZE;
+        ts_delta_stats.update(delta);
+        hist_ts_delta->record_ns(delta);
 
         // Debug: log timestamp delta every 100 packets
         if (g_debug && (stats_callback_count % 100 == 0)) {
@@ -361,40 +719,143 @@ void update_ts_stats(uint64_t ts) {
     ts_last = ts;
 }
 
+// ============================================
+// Point Filter/Convert (shared kernel + selection policy)
+// ============================================
+//
+// The mm->m convert + range-gate kernel lives in the shared transport
+// library (lidar_transport.cpp, SIMD when available); this section owns
+// the selection policy fed into it: adaptive downsampling and budgeted
+// azimuth-sector quotas.
+
+// Effective downsample factor for the filter loop (adaptive or fixed)
+static inline int effective_downsample() {
+    return g_adaptive ? g_adapt_factor.load(std::memory_order_relaxed)
+                      : g_downsample;
+}
+
 /**
- * Calculate timestamp statistics (mean, stddev)
+ * Azimuth sector of a point (BUDGET_SECTORS half-quadrants)
+ *
+ * Three sign/magnitude tests instead of atan2: the sectors are not
+ * angle-ordered, but budgeted selection only needs them to partition the
+ * horizontal field of view evenly, not to be sorted.
  */
-void calc_ts_stats(double* mean_ms, double* stddev_ms) {
-    if (ts_history_idx == 0 && ts_history[0] == 0) {
-        *mean_ms = 0.0;
-        *stddev_ms = 0.0;
-        return;
+static inline int azimuth_sector(float x, float y) {
+    return ((y < 0.0f) << 2) | ((x < 0.0f) << 1) | (fabsf(y) > fabsf(x));
+}
+
+/**
+ * Begin a budgeted-selection callback: accrue credit and derive quotas
+ *
+ * Credit accrues at the (possibly backpressure-scaled) target points/sec
+ * and is spent by kept points, so the selection tracks the real callback
+ * rate instead of assuming one. The per-callback allowance is split into
+ * equal per-sector quotas: Mid-360 scan order visits azimuth unevenly
+ * within a callback, and the modulo downsample it replaces systematically
+ * thinned some sectors more than others.
+ */
+static void budget_begin_callback(uint64_t now) {
+    int pps = g_budget_pps;
+    if (g_adaptive) {
+        // Honor congestion backoff: scale the budget down by the same
+        // multiplier the adaptive controller applies to the modulo factor
+        pps = (int)((int64_t)pps * g_downsample /
+                    g_adapt_factor.load(std::memory_order_relaxed));
     }
 
-    // Calculate mean
-    double sum = 0.0;
-    int count = 0;
-    for (int i = 0; i < TS_HISTORY_SIZE; i++) {
-        if (ts_history[i] > 0) {
-            sum += ts_history[i] / 1000000.0;  // Convert to ms
-            count++;
-        }
+    if (budget_last_ns != 0) {
+        uint64_t elapsed = now - budget_last_ns;
+        if (elapsed > BUDGET_CREDIT_CAP_NS) elapsed = BUDGET_CREDIT_CAP_NS;
+        budget_credit += (double)elapsed * pps / 1e9;
+        double cap = (double)pps * BUDGET_CREDIT_CAP_NS / 1e9;
+        if (budget_credit > cap) budget_credit = cap;
     }
-    *mean_ms = (count > 0) ? (sum / count) : 0.0;
+    budget_last_ns = now;
 
-    // Calculate stddev
-    if (count > 1) {
-        double var_sum = 0.0;
-        for (int i = 0; i < TS_HISTORY_SIZE; i++) {
-            if (ts_history[i] > 0) {
-                double delta_ms = ts_history[i] / 1000000.0;
-                var_sum += (delta_ms - *mean_ms) * (delta_ms - *mean_ms);
-            }
-        }
-        *stddev_ms = sqrt(var_sum / count);
-    } else {
-        *stddev_ms = 0.0;
+    budget_callback_cap = (int)budget_credit;
+    if (budget_callback_cap > MAX_FILTERED_POINTS) {
+        budget_callback_cap = MAX_FILTERED_POINTS;
+    }
+    budget_sector_quota = budget_callback_cap / BUDGET_SECTORS + 1;
+    budget_total_kept = 0;
+    budget_rejected_cb = 0;
+    memset(budget_sector_kept, 0, sizeof(budget_sector_kept));
+}
+
+/**
+ * Budgeted keep/reject decision for one filtered point (hot path)
+ *
+ * Accepts until the point's azimuth sector hits its quota or the callback
+ * allowance is spent. Branch-light and called only for points that already
+ * passed the range gate.
+ */
+static inline bool budget_keep(float x, float y) {
+    if (budget_total_kept >= budget_callback_cap) {
+        return false;
+    }
+    int s = azimuth_sector(x, y);
+    if (budget_sector_kept[s] >= budget_sector_quota) {
+        return false;
+    }
+    budget_sector_kept[s]++;
+    budget_total_kept++;
+    return true;
+}
+
+// End a budgeted-selection callback: spend credit and flush drop stats
+static void budget_end_callback() {
+    budget_credit -= budget_total_kept;
+    if (budget_credit < 0.0) budget_credit = 0.0;
+    if (budget_rejected_cb > 0) {
+        stats_budget_dropped.fetch_add(budget_rejected_cb, std::memory_order_relaxed);
+        budget_rejected_cb = 0;
+    }
+}
+
+/**
+ * Budgeted-selection trampoline for the shared filter kernel
+ */
+static bool budget_keep_cb(void* ctx, float x, float y, float z,
+                           uint8_t intensity) {
+    (void)ctx;
+    (void)z;
+    (void)intensity;
+    if (budget_keep(x, y)) {
+        return true;
     }
+    budget_rejected_cb++;
+    return false;
+}
+
+/**
+ * Filter and convert one callback's raw points into a Point3D buffer
+ *
+ * Thin wrapper over the shared transport kernel: wires the runtime range
+ * gate, the (possibly adaptive) downsample factor, and the budgeted
+ * selection callback, then folds the rejection count into the stats.
+ *
+ * @return Number of points written to out
+ */
+int filter_convert_points(const LivoxLidarCartesianHighRawPoint* raw, int n,
+                          Point3D* out, int max_out, int* skipped_overflow) {
+    lidar_transport::FilterParams params;
+    params.min_range = g_min_range;
+    params.max_range = g_max_range;
+    params.z_min = g_z_min;
+    params.z_max = g_z_max;
+    params.downsample = effective_downsample();
+    params.keep = (g_budget_pps > 0) ? budget_keep_cb : nullptr;
+    params.keep_ctx = nullptr;
+
+    uint64_t rejected = 0;
+    int written = lidar_transport::filter_convert_points(
+        raw, n, out, max_out, params, &rejected, skipped_overflow);
+
+    if (rejected > 0) {
+        stats_filtered_points.fetch_add(rejected, std::memory_order_relaxed);
+    }
+    return written;
 }
 
 // ============================================
@@ -402,26 +863,226 @@ void calc_ts_stats(double* mean_ms, double* stddev_ms) {
 // ============================================
 
 /**
- * Send a packet with header + points
+ * Quantize points into the v2 wire encoding (QuantBlock + int16 triples)
+ *
+ * Per-packet offset = per-axis midpoint, scale = largest axis span / 65534,
+ * so the full int16 range is always used: the tighter the packet's extent,
+ * the finer the resolution (never coarser than ~1.2mm at a 40m span).
+ *
+ * @param dst Destination (QUANT_BLOCK_SIZE + count * QUANT_POINT_SIZE bytes)
+ * @param points Source points
+ * @param count Number of points (>= 1)
+ */
+static void quantize_points(uint8_t* dst, const Point3D* points, uint16_t count) {
+    // Per-packet bounding box
+    float min_c[3] = {points[0].x, points[0].y, points[0].z};
+    float max_c[3] = {points[0].x, points[0].y, points[0].z};
+
+    for (uint16_t i = 1; i < count; i++) {
+        const Point3D* p = &points[i];
+        if (p->x < min_c[0]) min_c[0] = p->x;
+        if (p->x > max_c[0]) max_c[0] = p->x;
+        if (p->y < min_c[1]) min_c[1] = p->y;
+        if (p->y > max_c[1]) max_c[1] = p->y;
+        if (p->z < min_c[2]) min_c[2] = p->z;
+        if (p->z > max_c[2]) max_c[2] = p->z;
+    }
+
+    float span = max_c[0] - min_c[0];
+    if (max_c[1] - min_c[1] > span) span = max_c[1] - min_c[1];
+    if (max_c[2] - min_c[2] > span) span = max_c[2] - min_c[2];
+
+    // Guard against degenerate (single-point / coplanar) packets
+    float scale = span / 65534.0f;
+    if (scale < 1e-6f) {
+        scale = 1e-6f;
+    }
+
+    struct QuantBlock block;
+    block.offset_x = (min_c[0] + max_c[0]) * 0.5f;
+    block.offset_y = (min_c[1] + max_c[1]) * 0.5f;
+    block.offset_z = (min_c[2] + max_c[2]) * 0.5f;
+    block.scale = scale;
+    memcpy(dst, &block, QUANT_BLOCK_SIZE);
+
+    float inv_scale = 1.0f / scale;
+    uint8_t* out = dst + QUANT_BLOCK_SIZE;
+
+    for (uint16_t i = 0; i < count; i++) {
+        struct QuantPoint3D qp;
+        qp.x = (int16_t)lrintf((points[i].x - block.offset_x) * inv_scale);
+        qp.y = (int16_t)lrintf((points[i].y - block.offset_y) * inv_scale);
+        qp.z = (int16_t)lrintf((points[i].z - block.offset_z) * inv_scale);
+        qp.intensity = points[i].intensity;
+        memcpy(out, &qp, QUANT_POINT_SIZE);
+        out += QUANT_POINT_SIZE;
+    }
+}
+
+// ============================================
+// XOR Parity FEC
+// ============================================
+
+/**
+ * Parity accumulator (sender thread only)
+ *
+ * XORs the recovery header fields and point payloads of the current group;
+ * a parity packet is emitted after every g_fec_k data packets. The
+ * accumulator persists across flushes, so groups may span callbacks.
+ */
+struct FecAccumulator {
+    uint8_t  xor_payload[MAX_UDP_PAYLOAD];  // XOR of group point payloads
+    size_t   max_len;            // Longest payload in the group (XOR byte length)
+    uint64_t xor_ts;             // XOR of device timestamps
+    uint32_t base_seq;           // seq of the first packet in the group
+    uint16_t xor_count;          // XOR of point_count fields
+    uint16_t xor_flags;          // XOR of flags fields
+    uint16_t xor_len;            // XOR of payload lengths
+    int      n;                  // Data packets accumulated so far
+};
+static FecAccumulator g_fec;
+
+/**
+ * Max points per packet for the active encoding
+ *
+ * Quantized packets give up one point when FEC is on so the parity packet
+ * (8-byte FecBlock + longest payload) stays within MAX_UDP_PAYLOAD; the
+ * float32 layout already leaves enough slack (1365 + 8 + 27 = 1400).
+ * The latency-probe trailer consumes that slack, so with the probe on the
+ * budget is recomputed from the wire limit (float32 + FEC drops to 104).
+ */
+int max_points_per_packet() {
+    if (!g_latency_probe) {
+        if (!g_quantize) {
+            return MAX_POINTS_PER_PACKET;
+        }
+        return (g_fec_k > 0) ? FEC_MAX_QUANT_POINTS_PER_PACKET
+                             : MAX_QUANT_POINTS_PER_PACKET;
+    }
+
+    int avail = MAX_UDP_PAYLOAD - HEADER_SIZE - HOST_TS_TRAILER_SIZE;
+    if (g_fec_k > 0) {
+        avail -= FEC_BLOCK_SIZE;  // The parity packet must fit too
+    }
+    if (!g_quantize) {
+        return avail / POINT_SIZE;
+    }
+    return (avail - QUANT_BLOCK_SIZE) / QUANT_POINT_SIZE;
+}
+
+/**
+ * Fold one built data packet into the parity accumulator
+ *
+ * @param packet Fully built packet (header + payload, post-compression)
+ * @param packet_len Total packet length in bytes
+ * @return true when the group is complete and a parity packet is due
+ */
+bool fec_accumulate(const uint8_t* packet, size_t packet_len) {
+    struct PacketHeader header;
+    memcpy(&header, packet, sizeof(header));
+
+    size_t payload_len = packet_len - HEADER_SIZE;
+
+    if (g_fec.n == 0) {
+        memset(g_fec.xor_payload, 0, sizeof(g_fec.xor_payload));
+        g_fec.max_len = 0;
+        g_fec.xor_ts = 0;
+        g_fec.base_seq = header.seq;
+        g_fec.xor_count = 0;
+        g_fec.xor_flags = 0;
+        g_fec.xor_len = 0;
+    }
+
+    for (size_t i = 0; i < payload_len; i++) {
+        g_fec.xor_payload[i] ^= packet[HEADER_SIZE + i];
+    }
+    if (payload_len > g_fec.max_len) {
+        g_fec.max_len = payload_len;
+    }
+    g_fec.xor_ts ^= header.device_timestamp;
+    g_fec.xor_count ^= header.point_count;
+    g_fec.xor_flags ^= header.flags;
+    g_fec.xor_len ^= (uint16_t)payload_len;
+    g_fec.n++;
+
+    return g_fec.n >= g_fec_k;
+}
+
+/**
+ * Build the parity packet for the completed group and reset the accumulator
  *
+ * @param buffer Output buffer (must hold at least MAX_UDP_PAYLOAD bytes)
+ * @return Packet size in bytes
+ */
+size_t fec_build_parity(uint8_t* buffer) {
+    struct PacketHeader header;
+    header.magic = PROTOCOL_MAGIC;
+    header.version = PROTOCOL_VERSION;
+    header.device_timestamp = g_fec.xor_ts;
+    header.seq = g_fec.base_seq;                   // First protected seq
+    header.point_count = (uint16_t)g_fec.max_len;  // XOR byte length
+    header.flags = FLAG_FEC_PARITY;
+    header.sensor_id = 0;
+    header.crc32 = 0;
+
+    struct FecBlock fec;
+    fec.k = (uint8_t)g_fec.n;
+    fec.reserved = 0;
+    fec.xor_point_count = g_fec.xor_count;
+    fec.xor_flags = g_fec.xor_flags;
+    fec.xor_len = g_fec.xor_len;
+
+    memcpy(buffer, &header, HEADER_SIZE - 4);
+    memcpy(buffer + HEADER_SIZE, &fec, FEC_BLOCK_SIZE);
+    memcpy(buffer + HEADER_SIZE + FEC_BLOCK_SIZE, g_fec.xor_payload, g_fec.max_len);
+
+    size_t packet_len = HEADER_SIZE + FEC_BLOCK_SIZE + g_fec.max_len;
+
+    // Parity CRC protects the recovered bytes too (same scheme as data)
+    if (g_crc_enabled) {
+        uint32_t crc = 0xFFFFFFFF;
+        crc = crc32_update(crc, buffer, HEADER_SIZE - 4);
+        crc = crc32_update(crc, buffer + HEADER_SIZE, packet_len - HEADER_SIZE);
+        crc ^= 0xFFFFFFFF;
+        memcpy(buffer + (HEADER_SIZE - 4), &crc, 4);
+    } else {
+        uint32_t zero = 0;
+        memcpy(buffer + (HEADER_SIZE - 4), &zero, 4);
+    }
+
+    g_fec.n = 0;
+    stats_fec_parity_packets.fetch_add(1, std::memory_order_relaxed);
+    stats_fec_parity_bytes.fetch_add(packet_len, std::memory_order_relaxed);
+    return packet_len;
+}
+
+/**
+ * Build a packet (header + points + optional CRC) into a caller-provided buffer
+ *
+ * Encoding follows g_quantize: v1 float32 points (13 B/pt) or v2 quantized
+ * int16 points (16 B block + 7 B/pt, FLAG_QUANT_POINTS set in flags).
+ *
+ * @param buffer Output buffer (must hold at least MAX_UDP_PAYLOAD bytes)
  * @param device_ts Device timestamp (nanoseconds)
  * @param points Point array
- * @param count Number of points (must be <= MAX_POINTS_PER_PACKET)
- * @return 0 on success, -1 on failure
+ * @param count Number of points (must be <= max for the active encoding)
+ * @return Payload size in bytes, 0 on error
  */
-int send_packet(uint64_t device_ts, Point3D* points, uint16_t count) {
-    if (count == 0 || count > MAX_POINTS_PER_PACKET) {
-        fprintf(stderr, "⚠ Invalid point count: %u (max %d)\n", count, MAX_POINTS_PER_PACKET);
-        return -1;
+size_t build_packet(uint8_t* buffer, uint64_t device_ts, Point3D* points, uint16_t count) {
+    int max_points = max_points_per_packet();
+    if (count == 0 || count > max_points) {
+        fprintf(stderr, "⚠ Invalid point count: %u (max %d)\n", count, max_points);
+        return 0;
     }
 
     // Calculate payload size
-    size_t payload_size = HEADER_SIZE + count * POINT_SIZE;
-    uint8_t buffer[MAX_UDP_PAYLOAD];
+    size_t payload_size = g_quantize
+        ? HEADER_SIZE + QUANT_BLOCK_SIZE + count * QUANT_POINT_SIZE
+        : HEADER_SIZE + count * POINT_SIZE;
 
     if (payload_size > MAX_UDP_PAYLOAD) {
         fprintf(stderr, "⚠ Payload too large: %zu > %d\n", payload_size, MAX_UDP_PAYLOAD);
-        return -1;
+        return 0;
     }
 
     // Get sequence number (atomic)
@@ -445,32 +1106,74 @@ int send_packet(uint64_t device_ts, Point3D* points, uint16_t count) {
     header.device_timestamp = device_ts;
     header.seq = seq;
     header.point_count = count;
-    header.flags = 0;
+    header.flags = g_quantize ? FLAG_QUANT_POINTS : 0;
     header.sensor_id = 0;
     header.crc32 = 0;  // Will be calculated below if enabled
 
+    // Copy/encode points to buffer
+    if (g_quantize) {
+        quantize_points(buffer + HEADER_SIZE, points, count);
+    } else {
+        memcpy(buffer + HEADER_SIZE, points, count * POINT_SIZE);
+    }
+
+#ifdef HAVE_LZ4
+    // Optional LZ4 compression of the encoded point payload. Falls back to
+    // raw if the packet does not shrink (flag stays clear, receiver parses
+    // as usual). The receiver derives the decompressed size from
+    // point_count + the encoding flag, so no extra length field is needed.
+    if (g_compress) {
+        static uint8_t lz4_scratch[MAX_UDP_PAYLOAD];  // Sender thread only
+        int raw_len = (int)(payload_size - HEADER_SIZE);
+
+        struct timespec t0, t1;
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        int comp_len = LZ4_compress_fast((const char*)(buffer + HEADER_SIZE),
+                                         (char*)lz4_scratch,
+                                         raw_len, raw_len - 1,
+                                         COMPRESS_ACCELERATION);
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        stats_compress_time_us.fetch_add(
+            (uint64_t)(t1.tv_sec - t0.tv_sec) * 1000000 +
+            (t1.tv_nsec - t0.tv_nsec) / 1000,
+            std::memory_order_relaxed);
+
+        if (comp_len > 0) {
+            // Compressed payload fits in raw_len - 1: worth sending
+            memcpy(buffer + HEADER_SIZE, lz4_scratch, comp_len);
+            payload_size = HEADER_SIZE + comp_len;
+            header.flags |= FLAG_COMPRESSED_LZ4;
+            stats_compressed_packets.fetch_add(1, std::memory_order_relaxed);
+            stats_compress_saved_bytes.fetch_add(raw_len - comp_len,
+                                                 std::memory_order_relaxed);
+        } else {
+            stats_compress_fallbacks.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+#endif
+
+    // Latency probe: stamp the host send time as an 8-byte trailer after
+    // the (possibly compressed) point payload. Stamped as late as possible
+    // so the RTT excludes build time; covered by the CRC below.
+    if (g_latency_probe) {
+        header.flags |= FLAG_HOST_TS;
+        uint64_t host_ns = get_monotonic_ns();
+        memcpy(buffer + payload_size, &host_ns, HOST_TS_TRAILER_SIZE);
+        payload_size += HOST_TS_TRAILER_SIZE;
+    }
+
     // Copy header to buffer (first 23 bytes, excluding CRC)
     memcpy(buffer, &header, HEADER_SIZE - 4);  // Copy up to CRC field
 
-    // Copy points to buffer
-    memcpy(buffer + HEADER_SIZE, points, count * POINT_SIZE);
-
     // Calculate CRC if enabled
     if (g_crc_enabled) {
-        // CRC over: header[0..22] + payload (excluding CRC field itself)
-        // Create temporary buffer without CRC field
-        size_t header_part = HEADER_SIZE - 4;  // 23 bytes
-        size_t payload_part = count * POINT_SIZE;
-
-        // Allocate temp buffer for CRC calculation
-        uint8_t* crc_buf = (uint8_t*)malloc(header_part + payload_part);
-        memcpy(crc_buf, buffer, header_part);  // Copy header[0..22]
-        memcpy(crc_buf + header_part, buffer + HEADER_SIZE, payload_part);  // Copy points
-
-        uint32_t crc = crc32_calculate(crc_buf, header_part + payload_part);
-        free(crc_buf);
-
-        header.crc32 = crc;
+        // CRC over: header[0..22] + payload (excluding CRC field itself),
+        // computed incrementally over the two in-place regions of buffer[].
+        // No per-packet heap allocation in the hot path.
+        uint32_t crc = 0xFFFFFFFF;
+        crc = crc32_update(crc, buffer, HEADER_SIZE - 4);
+        crc = crc32_update(crc, buffer + HEADER_SIZE, payload_size - HEADER_SIZE);
+        crc ^= 0xFFFFFFFF;
 
         // Copy CRC to buffer
         memcpy(buffer + (HEADER_SIZE - 4), &crc, 4);
@@ -480,37 +1183,15 @@ int send_packet(uint64_t device_ts, Point3D* points, uint16_t count) {
         memcpy(buffer + (HEADER_SIZE - 4), &zero, 4);
     }
 
-    // Send UDP packet
-    ssize_t sent = sendto(udp_socket, buffer, payload_size, 0,
-                          (struct sockaddr*)&target_addr, sizeof(target_addr));
-
-    if (sent < 0) {
-        if (errno == EAGAIN || errno == EWOULDBLOCK) {
-            stats_dropped_packets.fetch_add(1, std::memory_order_relaxed);
-            stats_send_eagain.fetch_add(1, std::memory_order_relaxed);
-            return -1;  // Buffer full
-        }
-        perror("sendto failed");
-        return -1;
-    }
-
-    if ((size_t)sent != payload_size) {
-        fprintf(stderr, "⚠ Partial send: %zd / %zu bytes\n", sent, payload_size);
-        return -1;
-    }
-
-    // Update stats (atomic)
-    stats_tx_packets.fetch_add(1, std::memory_order_relaxed);
-    stats_tx_points.fetch_add(count, std::memory_order_relaxed);
-    stats_tx_bytes.fetch_add(payload_size, std::memory_order_relaxed);
-
-    return 0;
+    return payload_size;
 }
 
 /**
- * Send point cloud with segmentation
+ * Send point cloud with segmentation (batched path)
  *
- * Splits large point clouds into multiple packets (MAX_POINTS_PER_PACKET each)
+ * Builds all segment buffers for one callback, then hands them to the
+ * shared sender, which flushes them with one sendmmsg() syscall per batch
+ * (degrading to a sendto() loop on kernels without sendmmsg()).
  *
  * @param device_ts Device timestamp
  * @param points Point array
@@ -522,32 +1203,396 @@ int send_segmented(uint64_t device_ts, Point3D* points, int total_count) {
         return 0;
     }
 
-    int packets_sent = 0;
+    // Pre-built segment buffers (static: only the sender thread calls this)
+    static uint8_t seg_buffers[MAX_SEGMENTS_PER_FLUSH][MAX_UDP_PAYLOAD];
+    static struct iovec seg_iov[MAX_SEGMENTS_PER_FLUSH];
+    static uint16_t seg_counts[MAX_SEGMENTS_PER_FLUSH];
+
+    // Build all segment buffers for this callback
+    const int max_pts = max_points_per_packet();
+    int num_segments = 0;
     int remaining = total_count;
     int offset = 0;
 
-    while (remaining > 0) {
-        int batch_size = (remaining > MAX_POINTS_PER_PACKET) ? MAX_POINTS_PER_PACKET : remaining;
+    while (remaining > 0 && num_segments < MAX_SEGMENTS_PER_FLUSH) {
+        int batch_size = (remaining > max_pts) ? max_pts : remaining;
 
-        if (send_packet(device_ts, points + offset, batch_size) == 0) {
-            packets_sent++;
-            if (total_count > MAX_POINTS_PER_PACKET) {
-                // This is a segmented packet
-                stats_segmented_packets.fetch_add(1, std::memory_order_relaxed);
-                stats_points_segmented.fetch_add(batch_size, std::memory_order_relaxed);
-            }
-        } else {
-            // Send failed
+        size_t payload_size = build_packet(seg_buffers[num_segments], device_ts,
+                                           points + offset, batch_size);
+        if (payload_size == 0) {
             stats_points_dropped_cap.fetch_add(remaining, std::memory_order_relaxed);
-            fprintf(stderr, "⚠ Segmentation failed: dropped %d points\n", remaining);
             return -1;
         }
 
+        seg_iov[num_segments].iov_base = seg_buffers[num_segments];
+        seg_iov[num_segments].iov_len = payload_size;
+        seg_counts[num_segments] = (uint16_t)batch_size;
+        num_segments++;
         offset += batch_size;
         remaining -= batch_size;
+
+        // Completed parity group: append the parity packet to this flush.
+        // 32 slots always suffice: a 2048-pt batch is at most 20 data
+        // segments, plus at most 10 parity segments at the k=2 minimum.
+        if (g_fec_k > 0 && fec_accumulate(seg_buffers[num_segments - 1], payload_size) &&
+            num_segments < MAX_SEGMENTS_PER_FLUSH) {
+            size_t parity_size = fec_build_parity(seg_buffers[num_segments]);
+            seg_iov[num_segments].iov_base = seg_buffers[num_segments];
+            seg_iov[num_segments].iov_len = parity_size;
+            seg_counts[num_segments] = 0;   // Parity carries no points
+            num_segments++;
+        }
+    }
+
+    // Flush all segments through the shared sender
+    lidar_transport::UdpSender::FlushResult res;
+    uint64_t flush_start = get_monotonic_ns();
+    int sent = g_sender.flush(seg_iov, num_segments, &res);
+    hist_sendmmsg->record_ns(get_monotonic_ns() - flush_start);
+
+    if (sent < 0) {
+        return -1;
+    }
+
+    // Per-segment accounting for what the kernel accepted
+    for (int i = 0; i < sent; i++) {
+        stats_tx_packets.fetch_add(1, std::memory_order_relaxed);
+        stats_tx_points.fetch_add(seg_counts[i], std::memory_order_relaxed);
+        stats_tx_bytes.fetch_add(seg_iov[i].iov_len, std::memory_order_relaxed);
+        if (total_count > max_pts) {
+            stats_segmented_packets.fetch_add(1, std::memory_order_relaxed);
+            stats_points_segmented.fetch_add(seg_counts[i], std::memory_order_relaxed);
+        }
+    }
+
+    // Socket buffer filled mid-flush: drop the unsent tail
+    if (res.eagain) {
+        int unsent = num_segments - sent;
+        stats_dropped_packets.fetch_add(unsent, std::memory_order_relaxed);
+        stats_send_eagain.fetch_add(1, std::memory_order_relaxed);
+        for (int i = sent; i < num_segments; i++) {
+            stats_points_dropped_cap.fetch_add(seg_counts[i], std::memory_order_relaxed);
+        }
+        return -1;
+    }
+
+    // Flush statistics (per-flush batch size)
+    stats_flush_count.fetch_add(1, std::memory_order_relaxed);
+    stats_flush_segments.fetch_add(num_segments, std::memory_order_relaxed);
+    uint32_t prev_max = stats_flush_max_batch.load(std::memory_order_relaxed);
+    while ((uint32_t)num_segments > prev_max &&
+           !stats_flush_max_batch.compare_exchange_weak(prev_max, (uint32_t)num_segments,
+                                                        std::memory_order_relaxed)) {
+    }
+
+    // Leftover beyond MAX_SEGMENTS_PER_FLUSH (should not happen with 2048-pt buffer)
+    if (remaining > 0) {
+        int more = send_segmented(device_ts, points + offset, remaining);
+        if (more > 0) sent += more;
+    }
+
+    return sent;
+}
+
+// ============================================
+// Transmit Pipeline (SPSC ring + sender thread)
+// ============================================
+
+/**
+ * Point batch: one callback's worth of filtered points
+ */
+struct PointBatch {
+    uint64_t device_ts;
+    int count;
+    Point3D points[MAX_FILTERED_POINTS];
+};
+
+// Lock-free SPSC ring: producer = Livox callback thread, consumer = sender thread.
+// head is only written by the producer, tail only by the consumer.
+static PointBatch tx_ring[TX_RING_SIZE];
+std::atomic<uint32_t> tx_ring_head(0);   // Next slot to publish (producer)
+std::atomic<uint32_t> tx_ring_tail(0);   // Next slot to drain (consumer)
+
+// Ring statistics
+std::atomic<uint64_t> stats_ring_batches(0);    // Batches enqueued
+std::atomic<uint64_t> stats_ring_overruns(0);   // Batches dropped (ring full)
+std::atomic<uint32_t> stats_ring_hwm(0);        // Occupancy high-water-mark
+
+// Sender thread handle
+std::thread sender_thread;
+std::atomic<bool> sender_running(false);
+
+/**
+ * Acquire the next free ring slot (producer side)
+ *
+ * @return Slot to fill, or nullptr if the ring is full (overrun)
+ */
+PointBatch* tx_ring_acquire() {
+    uint32_t head = tx_ring_head.load(std::memory_order_relaxed);
+    uint32_t tail = tx_ring_tail.load(std::memory_order_acquire);
+
+    if (head - tail >= TX_RING_SIZE) {
+        return nullptr;  // Ring full: sender thread can't keep up
+    }
+    return &tx_ring[head & TX_RING_MASK];
+}
+
+/**
+ * Publish the acquired slot (producer side)
+ */
+void tx_ring_publish() {
+    uint32_t head = tx_ring_head.load(std::memory_order_relaxed);
+    tx_ring_head.store(head + 1, std::memory_order_release);
+
+    stats_ring_batches.fetch_add(1, std::memory_order_relaxed);
+
+    // Track occupancy high-water-mark
+    uint32_t occupancy = (head + 1) - tx_ring_tail.load(std::memory_order_relaxed);
+    uint32_t prev_hwm = stats_ring_hwm.load(std::memory_order_relaxed);
+    while (occupancy > prev_hwm &&
+           !stats_ring_hwm.compare_exchange_weak(prev_hwm, occupancy,
+                                                 std::memory_order_relaxed)) {
+    }
+}
+
+/**
+ * Sender thread main loop
+ *
+ * Drains the ring and does segmentation + transmit, so network stalls
+ * never backpressure the Livox SDK callback thread.
+ */
+void sender_thread_main() {
+    tl_on_packet_path = true;  // Allocations here count as regressions
+
+    while (true) {
+        uint32_t tail = tx_ring_tail.load(std::memory_order_relaxed);
+
+        if (tail == tx_ring_head.load(std::memory_order_acquire)) {
+            // Ring empty: exit once shutdown is requested, otherwise idle
+            if (!sender_running.load(std::memory_order_relaxed)) {
+                break;
+            }
+            usleep(TX_IDLE_SLEEP_USEC);
+            continue;
+        }
+
+        PointBatch* batch = &tx_ring[tail & TX_RING_MASK];
+        send_segmented(batch->device_ts, batch->points, batch->count);
+
+        // Release slot back to producer
+        tx_ring_tail.store(tail + 1, std::memory_order_release);
+    }
+}
+
+// ============================================
+// Latency Echo Listener
+// ============================================
+
+/**
+ * Echo listener thread (--latency-probe)
+ *
+ * The receiver replies to the datagram source address, so echoes arrive
+ * on the sender's own socket; recv() here never contends with the sender
+ * thread's sendmmsg(). Each echo yields one RTT sample, and the sample
+ * with the smallest RTT carries the cleanest clock-offset estimate
+ * (offset = rx_recv - (host_send + rtt/2), assuming a symmetric path).
+ */
+void echo_listener_main() {
+    // Bounded recv so the loop notices shutdown on an idle link
+    struct timeval timeout;
+    timeout.tv_sec = 0;
+    timeout.tv_usec = 100000;  // 100ms
+    setsockopt(g_sender.fd(), SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    EchoPacket echo;
+    while (echo_running.load(std::memory_order_relaxed)) {
+        ssize_t n = recv(g_sender.fd(), &echo, sizeof(echo), 0);
+        if (n < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+                continue;  // Idle link or signal: re-check echo_running
+            }
+            break;
+        }
+        if (n != (ssize_t)sizeof(echo) || echo.magic != ECHO_MAGIC) {
+            continue;  // Not an echo (stray datagram to our port)
+        }
+
+        uint64_t now = get_monotonic_ns();
+        if (now <= echo.host_send_ns) {
+            continue;  // Clock anomaly or corrupt echo
+        }
+
+        uint64_t rtt = now - echo.host_send_ns;
+        hist_echo_rtt->record_ns(rtt);
+        stats_echoes_received.fetch_add(1, std::memory_order_relaxed);
+
+        if (rtt < stats_echo_best_rtt_ns.load(std::memory_order_relaxed)) {
+            stats_echo_best_rtt_ns.store(rtt, std::memory_order_relaxed);
+            stats_echo_offset_ns.store(
+                (int64_t)echo.rx_recv_ns - (int64_t)(echo.host_send_ns + rtt / 2),
+                std::memory_order_relaxed);
+        }
+    }
+}
+
+// ============================================
+// Adaptive Downsampling
+// ============================================
+
+/**
+ * Closed-loop downsample controller (callback thread)
+ *
+ * Evaluated once per ADAPT_WINDOW_NS (~100ms): if the send side reported
+ * congestion during the window (EAGAIN from the socket or ring overruns),
+ * the effective downsample factor doubles immediately; after
+ * ADAPT_RECOVER_WINDOWS consecutive clean windows it halves back toward
+ * the configured g_downsample. This lets g_downsample be provisioned for
+ * the idle link instead of worst-case WiFi.
+ */
+void adapt_update(uint64_t now) {
+    if (adapt_window_start == 0) {
+        adapt_window_start = now;
+        adapt_last_congestion = stats_send_eagain.load(std::memory_order_relaxed) +
+                                stats_ring_overruns.load(std::memory_order_relaxed);
+        return;
+    }
+    if (now - adapt_window_start < ADAPT_WINDOW_NS) {
+        return;
+    }
+
+    uint64_t congestion = stats_send_eagain.load(std::memory_order_relaxed) +
+                          stats_ring_overruns.load(std::memory_order_relaxed);
+    const int base = (g_downsample > 1) ? g_downsample : 1;
+    int factor = g_adapt_factor.load(std::memory_order_relaxed);
+
+    if (congestion != adapt_last_congestion) {
+        // Congestion seen this window: back off (double the factor)
+        int ceiling = base * ADAPT_MAX_MULTIPLIER;
+        if (factor < ceiling) {
+            int next = factor * 2;
+            if (next > ceiling) next = ceiling;
+            g_adapt_factor.store(next, std::memory_order_relaxed);
+            stats_adapt_backoffs.fetch_add(1, std::memory_order_relaxed);
+            if (g_debug) {
+                fprintf(stderr, "⚙ Adaptive: congestion, downsample 1/%d -> 1/%d\n",
+                        factor, next);
+            }
+        }
+        adapt_clean_windows = 0;
+    } else if (factor > base) {
+        // Clean window: recover only after a sustained quiet period
+        if (++adapt_clean_windows >= ADAPT_RECOVER_WINDOWS) {
+            int next = factor / 2;
+            if (next < base) next = base;
+            g_adapt_factor.store(next, std::memory_order_relaxed);
+            stats_adapt_recoveries.fetch_add(1, std::memory_order_relaxed);
+            adapt_clean_windows = 0;
+            if (g_debug) {
+                fprintf(stderr, "⚙ Adaptive: link clear, downsample 1/%d -> 1/%d\n",
+                        factor, next);
+            }
+        }
+    } else {
+        adapt_clean_windows = 0;
+    }
+
+    adapt_last_congestion = congestion;
+    adapt_window_start = now;
+}
+
+// ============================================
+// Telemetry Snapshot
+// ============================================
+
+/**
+ * Build the telemetry JSON snapshot (relaxed atomic reads only)
+ *
+ * Called from the telemetry server thread when a scraper asks; the
+ * counters are the same atomics the stats printer reads, so the packet
+ * hot path is untouched.
+ */
+static size_t telemetry_snapshot(char* buf, size_t cap) {
+    using telemetry::append;
+#define LD(a) (unsigned long long)(a).load(std::memory_order_relaxed)
+
+    size_t off = 0;
+    off = append(buf, cap, off, "{\"role\":\"tx\",");
+
+    off = append(buf, cap, off,
+                 "\"tx\":{\"packets\":%llu,\"points\":%llu,\"bytes\":%llu,"
+                 "\"dropped_packets\":%llu,\"send_eagain\":%llu,"
+                 "\"filtered_points\":%llu,\"callbacks\":%llu,"
+                 "\"seq_wraps\":%llu,\"hot_path_allocs\":%llu},",
+                 LD(stats_tx_packets), LD(stats_tx_points), LD(stats_tx_bytes),
+                 LD(stats_dropped_packets), LD(stats_send_eagain),
+                 LD(stats_filtered_points), LD(stats_callback_count),
+                 (unsigned long long)stats_seq_wraps.load(std::memory_order_relaxed),
+                 LD(stats_packet_allocs));
+
+    off = append(buf, cap, off,
+                 "\"segmentation\":{\"packets\":%llu,\"points\":%llu,"
+                 "\"dropped_cap\":%llu},",
+                 LD(stats_segmented_packets), LD(stats_points_segmented),
+                 LD(stats_points_dropped_cap));
+
+    off = append(buf, cap, off,
+                 "\"flush\":{\"count\":%llu,\"segments\":%llu,\"max_batch\":%u,"
+                 "\"sendmmsg_unavailable\":%s},",
+                 LD(stats_flush_count), LD(stats_flush_segments),
+                 stats_flush_max_batch.load(std::memory_order_relaxed),
+                 g_sender.sendmmsg_unavailable() ? "true" : "false");
+
+    off = append(buf, cap, off,
+                 "\"ring\":{\"batches\":%llu,\"overruns\":%llu,\"hwm\":%u},",
+                 LD(stats_ring_batches), LD(stats_ring_overruns),
+                 stats_ring_hwm.load(std::memory_order_relaxed));
+
+    if (g_compress) {
+        off = append(buf, cap, off,
+                     "\"compress\":{\"packets\":%llu,\"fallbacks\":%llu,"
+                     "\"saved_bytes\":%llu},",
+                     LD(stats_compressed_packets), LD(stats_compress_fallbacks),
+                     LD(stats_compress_saved_bytes));
+    }
+
+    if (g_fec_k > 0) {
+        off = append(buf, cap, off,
+                     "\"fec\":{\"k\":%d,\"parity_packets\":%llu,"
+                     "\"parity_bytes\":%llu},",
+                     g_fec_k, LD(stats_fec_parity_packets),
+                     LD(stats_fec_parity_bytes));
+    }
+
+    if (g_latency_probe) {
+        uint64_t best_rtt = stats_echo_best_rtt_ns.load(std::memory_order_relaxed);
+        off = append(buf, cap, off,
+                     "\"latency_probe\":{\"echoes\":%llu,"
+                     "\"best_rtt_ns\":%llu,\"offset_ns\":%lld},",
+                     LD(stats_echoes_received),
+                     (unsigned long long)(best_rtt == UINT64_MAX ? 0 : best_rtt),
+                     (long long)stats_echo_offset_ns.load(std::memory_order_relaxed));
     }
 
-    return packets_sent;
+    off = append(buf, cap, off,
+                 "\"selection\":{\"downsample\":%d,\"adaptive\":%s,"
+                 "\"adapt_backoffs\":%llu,\"adapt_recoveries\":%llu,"
+                 "\"budget_pps\":%d,\"budget_dropped\":%llu},",
+                 effective_downsample(), g_adaptive ? "true" : "false",
+                 LD(stats_adapt_backoffs), LD(stats_adapt_recoveries),
+                 g_budget_pps, LD(stats_budget_dropped));
+
+    off = append(buf, cap, off,
+                 "\"ts_delta_ms\":{\"count\":%llu,\"mean\":%.3f,\"stddev\":%.3f,"
+                 "\"min\":%.3f,\"max\":%.3f},",
+                 LD(ts_delta_stats.count), ts_delta_stats.mean_ms(),
+                 ts_delta_stats.stddev_ms(), ts_delta_stats.min_ms(),
+                 ts_delta_stats.max_ms());
+
+    off = telemetry::histograms_json(buf, cap, off);
+    off = append(buf, cap, off, "}\n");
+
+#undef LD
+    return off;
 }
 
 // ============================================
@@ -563,6 +1608,10 @@ void PointCloudCallback(uint32_t handle, const uint8_t dev_type,
     (void)dev_type;
     (void)client_data;
 
+    // The SDK data-dispatch thread is a packet hot path too: filtering and
+    // the ring handoff must not allocate
+    tl_on_packet_path = true;
+
     // Early exit if shutting down
     if (!keep_running) {
         return;
@@ -575,6 +1624,14 @@ void PointCloudCallback(uint32_t handle, const uint8_t dev_type,
         return;
     }
 
+    // One-shot boot latency log: exec to first point callback (the figure
+    // the watchdog's sub-second restart target is judged on)
+    static std::atomic<bool> first_cb_logged(false);
+    if (!first_cb_logged.exchange(true, std::memory_order_relaxed)) {
+        printf("⏱️ First point callback %.1f ms after exec\n",
+               (get_monotonic_ns() - g_exec_start_ns) / 1e6);
+    }
+
     LivoxLidarCartesianHighRawPoint* raw_points =
         (LivoxLidarCartesianHighRawPoint*)data->data;
 
@@ -583,65 +1640,49 @@ void PointCloudCallback(uint32_t handle, const uint8_t dev_type,
     uint64_t device_ts = extract_livox_timestamp(data, fallback_ts);
     update_ts_stats(device_ts);
 
-    // Allocate buffer for filtered points (large enough for segmentation)
-    const int MAX_FILTERED = 2048;  // Support up to 2048 points per callback
-    static Point3D filtered[MAX_FILTERED];
-    int filtered_count = 0;
-
-    float min2 = g_min_range * g_min_range;
-    float max2 = g_max_range * g_max_range;
-
-    // Filter and convert points
-    int skipped_overflow = 0;
-    for (int i = 0; i < data->dot_num; i++) {
-        // Check buffer overflow (should never happen with 2048 buffer)
-        if (filtered_count >= MAX_FILTERED) {
-            skipped_overflow++;
-            continue;
-        }
-
-        // Skip invalid (0,0,0) points
-        if (raw_points[i].x == 0 && raw_points[i].y == 0 && raw_points[i].z == 0) {
-            stats_filtered_points.fetch_add(1, std::memory_order_relaxed);
-            continue;
-        }
-
-        // Convert mm to meters
-        float x = raw_points[i].x / 1000.0f;
-        float y = raw_points[i].y / 1000.0f;
-        float z = raw_points[i].z / 1000.0f;
+    // Closed-loop downsample control (evaluates every ~100ms)
+    if (g_adaptive) {
+        adapt_update(fallback_ts);
+    }
 
-        // Distance gating
-        float d2 = x*x + y*y + z*z;
-        if (d2 < min2 || d2 > max2) {
-            stats_filtered_points.fetch_add(1, std::memory_order_relaxed);
-            continue;
-        }
+    // Acquire a ring slot: filtered points go straight into the slot so the
+    // batch reaches the sender thread without an extra copy
+    PointBatch* batch = tx_ring_acquire();
+    if (batch == nullptr) {
+        // Ring full: drop this callback's points rather than block acquisition
+        stats_ring_overruns.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
 
-        // Downsampling
-        if (g_downsample > 1 && (i % g_downsample) != 0) {
-            stats_filtered_points.fetch_add(1, std::memory_order_relaxed);
-            continue;
-        }
+    // Budgeted selection: accrue credit and derive this callback's quotas
+    if (g_budget_pps > 0) {
+        budget_begin_callback(fallback_ts);
+    }
 
-        // Add to buffer
-        filtered[filtered_count].x = x;
-        filtered[filtered_count].y = y;
-        filtered[filtered_count].z = z;
-        filtered[filtered_count].intensity = raw_points[i].reflectivity;
-        filtered_count++;
+    // Filter and convert points (SIMD kernel when available)
+    int skipped_overflow = 0;
+    uint64_t filter_start = get_monotonic_ns();
+    int filtered_count = filter_convert_points(raw_points, data->dot_num,
+                                               batch->points, MAX_FILTERED_POINTS,
+                                               &skipped_overflow);
+    hist_filter->record_ns(get_monotonic_ns() - filter_start);
+
+    if (g_budget_pps > 0) {
+        budget_end_callback();
     }
 
     // Warn about buffer overflow (should never happen)
     if (skipped_overflow > 0) {
         fprintf(stderr, "⚠ WARNING: Filter buffer overflow! Skipped %d points (buffer size: %d)\n",
-                skipped_overflow, MAX_FILTERED);
+                skipped_overflow, MAX_FILTERED_POINTS);
         stats_points_dropped_cap.fetch_add(skipped_overflow, std::memory_order_relaxed);
     }
 
-    // Send with segmentation
+    // Hand off to the sender thread (no network I/O on the callback thread)
     if (filtered_count > 0) {
-        send_segmented(device_ts, filtered, filtered_count);
+        batch->device_ts = device_ts;
+        batch->count = filtered_count;
+        tx_ring_publish();
     }
 
     // Periodic logging
@@ -661,7 +1702,7 @@ void PointCloudCallback(uint32_t handle, const uint8_t dev_type,
             double mbps = ((bytes - rate_last_bytes) * 8.0) / elapsed / 1e6;
 
             printf("✓ CB #%lu: TX %lu pkts (%lu pts, %.1f pps, %.2f Mbit/s), "
-                   "Drop %lu, EAGAIN %lu, Seg %lu, Filt %lu\n",
+                   "Drop %lu, EAGAIN %lu, Seg %lu, Filt %lu, DS 1/%d (+%lu/-%lu)\n",
                    cb_count,
                    pkts,
                    stats_tx_points.load(std::memory_order_relaxed),
@@ -670,7 +1711,10 @@ void PointCloudCallback(uint32_t handle, const uint8_t dev_type,
                    stats_dropped_packets.load(std::memory_order_relaxed),
                    stats_send_eagain.load(std::memory_order_relaxed),
                    stats_segmented_packets.load(std::memory_order_relaxed),
-                   stats_filtered_points.load(std::memory_order_relaxed));
+                   stats_filtered_points.load(std::memory_order_relaxed),
+                   effective_downsample(),
+                   stats_adapt_backoffs.load(std::memory_order_relaxed),
+                   stats_adapt_recoveries.load(std::memory_order_relaxed));
 
             rate_last_packets = pkts;
             rate_last_bytes = bytes;
@@ -694,6 +1738,37 @@ void PointCloudCallback(uint32_t handle, const uint8_t dev_type,
 /**
  * Work mode callback
  */
+// ============================================
+// Handshake Cache
+// ============================================
+
+/**
+ * Persist the last connected device (SN + IP) next to the config file.
+ *
+ * A watchdog restart pays LivoxLidarSdkInit and discovery before the
+ * first packet flows; the cache lets the restarted sender report the
+ * expected device immediately while discovery proceeds in the background.
+ * Streaming itself never blocks on the cache: the UDP socket and sender
+ * thread are already up before the SDK initializes.
+ */
+void handshake_cache_save(const char* sn, const char* ip) {
+    if (g_handshake_path[0] == '\0') return;
+    FILE* f = fopen(g_handshake_path, "w");
+    if (f == nullptr) return;
+    fprintf(f, "%s %s\n", sn, ip);
+    fclose(f);
+}
+
+// Load the cached handshake (sn and ip must each hold >= 64 bytes)
+bool handshake_cache_load(char* sn, char* ip) {
+    if (g_handshake_path[0] == '\0') return false;
+    FILE* f = fopen(g_handshake_path, "r");
+    if (f == nullptr) return false;
+    bool ok = (fscanf(f, "%63s %63s", sn, ip) == 2);
+    fclose(f);
+    return ok;
+}
+
 void WorkModeCallback(livox_status status, uint32_t handle,
                       LivoxLidarAsyncControlResponse* response, void* client_data) {
     (void)handle;
@@ -723,6 +1798,9 @@ void LidarInfoChangeCallback(const uint32_t handle, const LivoxLidarInfo* info,
     printf("IP Address:    %s\n", inet_ntoa(*(struct in_addr*)&info->lidar_ip));
     printf("━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n");
 
+    // Persist the handshake so the next (watchdog) restart knows the device
+    handshake_cache_save(info->sn, inet_ntoa(*(struct in_addr*)&info->lidar_ip));
+
     SetLivoxLidarWorkMode(handle, kLivoxLidarNormal, WorkModeCallback, nullptr);
     printf("Requesting point cloud streaming...\n");
 }
@@ -754,20 +1832,96 @@ void print_usage(const char* prog) {
     printf("\nOptions:\n");
     printf("  --min-range <m>      Minimum distance filter (default: %.1f)\n", MIN_RANGE);
     printf("  --max-range <m>      Maximum distance filter (default: %.1f)\n", MAX_RANGE);
+    printf("  --z-min <m>          Reject points below this height (sensor frame)\n");
+    printf("  --z-max <m>          Reject points above this height\n");
+    printf("  --ground <h>         Ground-plane filter: sensor height above the\n");
+    printf("                       floor (m); drops returns below -h + tolerance\n");
+    printf("  --ground-tol <m>     Ground filter clearance (default: %.2f)\n", GROUND_TOLERANCE);
     printf("  --downsample <N>     Downsample factor (default: %d)\n", DOWNSAMPLE_FACTOR);
+    printf("  --adaptive           Closed-loop downsampling: back off on send\n");
+    printf("                       congestion (EAGAIN/overruns), recover when clear\n");
+    printf("  --budget <pps>       Target points/sec, selected by stratified\n");
+    printf("                       azimuth-sector quotas (replaces --downsample)\n");
+    printf("  --telemetry-port <p> UDP telemetry endpoint: any datagram to this\n");
+    printf("                       port gets a JSON counter snapshot back\n");
     printf("  --crc                Enable CRC32 checksums\n");
+    printf("  --quantize           Quantized int16 points (v2, %d pts/pkt)\n", MAX_QUANT_POINTS_PER_PACKET);
+#ifdef HAVE_LZ4
+    printf("  --compress           LZ4-compress point payloads\n");
+#endif
+    printf("  --fec <k>            XOR parity FEC: one parity packet per k data\n");
+    printf("                       packets (k = 2-%d; ~1/k bandwidth overhead,\n", FEC_MAX_K);
+    printf("                       recovers any single loss per group)\n");
+    printf("  --latency-probe      Stamp an 8-byte host send-time trailer into\n");
+    printf("                       every packet and listen for receiver echoes\n");
+    printf("                       (RTT + clock-offset estimate in the stats)\n");
+    printf("  --fast-start         Defer the config banner until streaming is\n");
+    printf("                       up (minimizes exec-to-first-packet time)\n");
     printf("  --debug              Enable debug logging\n");
     printf("\nEnvironment:\n");
     printf("  LIDAR_CRC32=1        Enable CRC (same as --crc)\n");
+    printf("  LIDAR_QUANTIZE=1     Quantized points (same as --quantize)\n");
+    printf("  LIDAR_COMPRESS=1     LZ4 compression (same as --compress)\n");
+    printf("  LIDAR_FEC=<k>        XOR parity FEC group size (same as --fec)\n");
     printf("  LIDAR_DEBUG=1        Enable debug logging\n");
     printf("  LIDAR_MIN_RANGE=<m>  Set min range\n");
     printf("  LIDAR_MAX_RANGE=<m>  Set max range\n");
+    printf("  LIDAR_Z_MIN=<m>      Set height band floor\n");
+    printf("  LIDAR_Z_MAX=<m>      Set height band ceiling\n");
+    printf("  LIDAR_GROUND=<h>     Ground-plane filter height (same as --ground)\n");
     printf("  LIDAR_DOWNSAMPLE=<N> Set downsample factor\n");
+    printf("  LIDAR_ADAPTIVE=1     Adaptive downsampling (same as --adaptive)\n");
+    printf("  LIDAR_BUDGET_PPS=<N> Target points/sec (same as --budget)\n");
+    printf("  LIDAR_TELEMETRY_PORT=<p> Telemetry port (same as --telemetry-port)\n");
+    printf("  LIDAR_LATENCY_PROBE=1 Latency probe (same as --latency-probe)\n");
+    printf("  LIDAR_FAST_START=1   Fast start (same as --fast-start)\n");
     printf("\nExample:\n");
     printf("  %s config.json 127.0.0.1 9999 --crc --max-range 15.0\n", prog);
 }
 
+// Configuration banner (fast-start defers this I/O until streaming is up)
+void print_config_banner(const char* config_file, const char* target_ip,
+                         int target_port) {
+    printf("========================================\n");
+    printf("G1 LiDAR Stream (Enhanced)\n");
+    printf("========================================\n");
+    printf("Protocol:     v%d (magic: 0x%08X)\n", PROTOCOL_VERSION, PROTOCOL_MAGIC);
+    printf("Endianness:   Little-endian ✓\n");
+    printf("Config:       %s\n", config_file);
+    printf("Target:       %s:%d\n", target_ip, target_port);
+    printf("Range:        %.1f - %.1f m\n", g_min_range, g_max_range);
+    if (g_z_min > -INFINITY || g_z_max < INFINITY) {
+        printf("Z band:       %.2f - %.2f m%s\n", g_z_min, g_z_max,
+               g_ground_height > 0.0f ? " (ground filter)" : "");
+    }
+    if (g_budget_pps > 0) {
+        printf("Budget:       %d pts/s (%d azimuth sectors%s)\n", g_budget_pps,
+               BUDGET_SECTORS, g_adaptive ? ", adaptive" : "");
+    } else {
+        printf("Downsample:   1/%d%s\n", g_downsample,
+               g_adaptive ? " (adaptive, cap x8)" : "");
+    }
+    printf("CRC32:        %s\n", g_crc_enabled ? "ENABLED" : "disabled");
+    printf("Encoding:     %s\n", g_quantize ? "quantized int16 (v2)" : "float32 (v1)");
+    printf("Compression:  %s\n", g_compress ? "LZ4" : "off");
+    if (g_fec_k > 0) {
+        printf("FEC:          XOR parity, k=%d (~%.0f%% overhead)\n",
+               g_fec_k, 100.0 / g_fec_k);
+    } else {
+        printf("FEC:          off\n");
+    }
+    printf("Latency probe: %s\n", g_latency_probe ? "ON (8B trailer + echo)" : "off");
+    printf("Debug:        %s\n", g_debug ? "ON" : "off");
+    printf("MTU:          %d bytes (max %d pts/pkt)\n", MAX_UDP_PAYLOAD,
+           max_points_per_packet());
+    printf("Header:       %d bytes\n", HEADER_SIZE);
+    printf("Point:        %d bytes\n", g_quantize ? QUANT_POINT_SIZE : POINT_SIZE);
+    printf("----------------------------------------\n\n");
+}
+
 int main(int argc, char** argv) {
+    g_exec_start_ns = get_monotonic_ns();
+
     // Check endianness
     if (!is_little_endian()) {
         fprintf(stderr, "❌ FATAL: System is not little-endian!\n");
@@ -777,16 +1931,38 @@ int main(int argc, char** argv) {
 
     // Parse environment variables
     const char* env_crc = getenv("LIDAR_CRC32");
+    const char* env_quantize = getenv("LIDAR_QUANTIZE");
+    const char* env_compress = getenv("LIDAR_COMPRESS");
+    const char* env_fec = getenv("LIDAR_FEC");
     const char* env_debug = getenv("LIDAR_DEBUG");
     const char* env_min_range = getenv("LIDAR_MIN_RANGE");
     const char* env_max_range = getenv("LIDAR_MAX_RANGE");
+    const char* env_z_min = getenv("LIDAR_Z_MIN");
+    const char* env_z_max = getenv("LIDAR_Z_MAX");
+    const char* env_ground = getenv("LIDAR_GROUND");
     const char* env_downsample = getenv("LIDAR_DOWNSAMPLE");
+    const char* env_adaptive = getenv("LIDAR_ADAPTIVE");
+    const char* env_budget = getenv("LIDAR_BUDGET_PPS");
+    const char* env_telemetry = getenv("LIDAR_TELEMETRY_PORT");
+    const char* env_fast_start = getenv("LIDAR_FAST_START");
+    const char* env_latency_probe = getenv("LIDAR_LATENCY_PROBE");
 
     if (env_crc && atoi(env_crc) == 1) g_crc_enabled = true;
+    if (env_quantize && atoi(env_quantize) == 1) g_quantize = true;
+    if (env_compress && atoi(env_compress) == 1) g_compress = true;
+    if (env_fec) g_fec_k = atoi(env_fec);
     if (env_debug && atoi(env_debug) == 1) g_debug = true;
     if (env_min_range) g_min_range = atof(env_min_range);
     if (env_max_range) g_max_range = atof(env_max_range);
+    if (env_z_min) g_z_min = atof(env_z_min);
+    if (env_z_max) g_z_max = atof(env_z_max);
+    if (env_ground) g_ground_height = atof(env_ground);
     if (env_downsample) g_downsample = atoi(env_downsample);
+    if (env_adaptive && atoi(env_adaptive) == 1) g_adaptive = true;
+    if (env_budget) g_budget_pps = atoi(env_budget);
+    if (env_telemetry) g_telemetry_port = atoi(env_telemetry);
+    if (env_fast_start && atoi(env_fast_start) == 1) g_fast_start = true;
+    if (env_latency_probe && atoi(env_latency_probe) == 1) g_latency_probe = true;
 
     // Parse arguments
     if (argc < 4) {
@@ -804,20 +1980,71 @@ int main(int argc, char** argv) {
             g_min_range = atof(argv[++i]);
         } else if (strcmp(argv[i], "--max-range") == 0 && i+1 < argc) {
             g_max_range = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--z-min") == 0 && i+1 < argc) {
+            g_z_min = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--z-max") == 0 && i+1 < argc) {
+            g_z_max = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--ground") == 0 && i+1 < argc) {
+            g_ground_height = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--ground-tol") == 0 && i+1 < argc) {
+            g_ground_tol = atof(argv[++i]);
         } else if (strcmp(argv[i], "--downsample") == 0 && i+1 < argc) {
             g_downsample = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--adaptive") == 0) {
+            g_adaptive = true;
+        } else if (strcmp(argv[i], "--budget") == 0 && i+1 < argc) {
+            g_budget_pps = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--telemetry-port") == 0 && i+1 < argc) {
+            g_telemetry_port = atoi(argv[++i]);
         } else if (strcmp(argv[i], "--crc") == 0) {
             g_crc_enabled = true;
+        } else if (strcmp(argv[i], "--quantize") == 0) {
+            g_quantize = true;
+        } else if (strcmp(argv[i], "--compress") == 0) {
+            g_compress = true;
+        } else if (strcmp(argv[i], "--fec") == 0 && i+1 < argc) {
+            g_fec_k = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--latency-probe") == 0) {
+            g_latency_probe = true;
+        } else if (strcmp(argv[i], "--fast-start") == 0) {
+            g_fast_start = true;
         } else if (strcmp(argv[i], "--debug") == 0) {
             g_debug = true;
         }
     }
 
-    // Initialize CRC table if enabled
-    if (g_crc_enabled) {
-        crc32_init_table();
+    // Handshake cache lives next to the config file
+    snprintf(g_handshake_path, sizeof(g_handshake_path), "%s.handshake",
+             config_file);
+
+    // Adaptive controller starts at the configured factor
+    if (g_downsample < 1) g_downsample = 1;
+    g_adapt_factor.store(g_downsample, std::memory_order_relaxed);
+
+    // Ground-plane filter: floor returns sit near z = -sensor_height, so
+    // raise the band floor to just above them (tighter explicit --z-min wins)
+    if (g_ground_height > 0.0f) {
+        float ground_floor = -g_ground_height + g_ground_tol;
+        if (ground_floor > g_z_min) {
+            g_z_min = ground_floor;
+        }
+    }
 
-        // Run CRC32 self-test
+    // FEC group size: k=1 would double every packet, cap at FEC_MAX_K
+    if (g_fec_k < 0) g_fec_k = 0;
+    if (g_fec_k == 1) g_fec_k = 2;
+    if (g_fec_k > FEC_MAX_K) g_fec_k = FEC_MAX_K;
+
+#ifndef HAVE_LZ4
+    if (g_compress) {
+        fprintf(stderr, "⚠ Built without LZ4 support: --compress ignored\n");
+        g_compress = false;
+    }
+#endif
+
+    // CRC tables are generated at compile time; the self-test is a debug
+    // sanity check, not a boot-path cost
+    if (g_crc_enabled && g_debug) {
         printf("========================================\n");
         printf("Running CRC32 Self-Test...\n");
         printf("========================================\n");
@@ -828,63 +2055,58 @@ int main(int argc, char** argv) {
         printf("\n");
     }
 
-    printf("========================================\n");
-    printf("G1 LiDAR Stream (Enhanced)\n");
-    printf("========================================\n");
-    printf("Protocol:     v%d (magic: 0x%08X)\n", PROTOCOL_VERSION, PROTOCOL_MAGIC);
-    printf("Endianness:   Little-endian ✓\n");
-    printf("Config:       %s\n", config_file);
-    printf("Target:       %s:%d\n", target_ip, target_port);
-    printf("Range:        %.1f - %.1f m\n", g_min_range, g_max_range);
-    printf("Downsample:   1/%d\n", g_downsample);
-    printf("CRC32:        %s\n", g_crc_enabled ? "ENABLED" : "disabled");
-    printf("Debug:        %s\n", g_debug ? "ON" : "off");
-    printf("MTU:          %d bytes (max %d pts/pkt)\n", MAX_UDP_PAYLOAD, MAX_POINTS_PER_PACKET);
-    printf("Header:       %d bytes\n", HEADER_SIZE);
-    printf("Point:        %d bytes\n", POINT_SIZE);
-    printf("----------------------------------------\n\n");
+    if (!g_fast_start) {
+        print_config_banner(config_file, target_ip, target_port);
+    }
 
-    // Register signal handlers
+    // Register signal handlers (SIGUSR1 dumps live latency percentiles)
     signal(SIGINT, signal_handler);
     signal(SIGTERM, signal_handler);
+    latency::install_sigusr1_dump();
 
-    // Create UDP socket
-    udp_socket = socket(AF_INET, SOCK_DGRAM, 0);
-    if (udp_socket < 0) {
-        perror("❌ Failed to create UDP socket");
+    // Create UDP socket (shared sender: SO_SNDTIMEO 100ms, 2MB SO_SNDBUF)
+    if (!g_sender.open(target_ip, target_port,
+                       SEND_TIMEOUT_SEC * 1000000L + SEND_TIMEOUT_USEC,
+                       2 * 1024 * 1024)) {
         return -1;
     }
 
-    // Set socket timeout
-    struct timeval timeout;
-    timeout.tv_sec = SEND_TIMEOUT_SEC;
-    timeout.tv_usec = SEND_TIMEOUT_USEC;
-    if (setsockopt(udp_socket, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout)) < 0) {
-        perror("⚠ WARNING: Failed to set SO_SNDTIMEO");
-    }
+    printf("✓ UDP socket created (target: %s:%d)\n", target_ip, target_port);
 
-    // Increase send buffer
-    int sndbuf = 2 * 1024 * 1024;  // 2MB
-    if (setsockopt(udp_socket, SOL_SOCKET, SO_SNDBUF, &sndbuf, sizeof(sndbuf)) < 0) {
-        perror("⚠ WARNING: Failed to set SO_SNDBUF");
+    // Start telemetry endpoint (non-fatal: streaming works without it)
+    if (g_telemetry_port > 0) {
+        if (g_telemetry.start((uint16_t)g_telemetry_port, telemetry_snapshot)) {
+            printf("✓ Telemetry endpoint on UDP port %d\n", g_telemetry_port);
+        } else {
+            fprintf(stderr, "⚠ WARNING: Telemetry endpoint failed to start\n");
+        }
     }
 
-    // Configure target address
-    memset(&target_addr, 0, sizeof(target_addr));
-    target_addr.sin_family = AF_INET;
-    target_addr.sin_port = htons(target_port);
-    if (inet_pton(AF_INET, target_ip, &target_addr.sin_addr) <= 0) {
-        fprintf(stderr, "❌ Invalid target IP: %s\n", target_ip);
-        close(udp_socket);
-        return -1;
+    // Start sender thread (drains the SPSC ring, owns all network I/O)
+    sender_running.store(true, std::memory_order_relaxed);
+    sender_thread = std::thread(sender_thread_main);
+    printf("✓ Sender thread started (ring: %d slots)\n", TX_RING_SIZE);
+
+    // Start the echo listener (RTT samples arrive on the sender's socket)
+    if (g_latency_probe) {
+        echo_running.store(true, std::memory_order_relaxed);
+        echo_thread = std::thread(echo_listener_main);
+        printf("✓ Latency probe armed (echo listener running)\n");
     }
 
-    printf("✓ UDP socket created (target: %s:%d)\n", target_ip, target_port);
+    // Fast restart: report the cached handshake immediately (discovery
+    // still runs in the background; the cache just tells the operator
+    // which device this sender expects without waiting for the SDK)
+    char cached_sn[64], cached_ip[64];
+    if (handshake_cache_load(cached_sn, cached_ip)) {
+        printf("↻ Last session: device %s at %s (rediscovering...)\n",
+               cached_sn, cached_ip);
+    }
 
     // Initialize Livox SDK
     if (!LivoxLidarSdkInit(config_file)) {
         fprintf(stderr, "❌ Livox SDK initialization failed\n");
-        close(udp_socket);
+        g_sender.close();
         return -1;
     }
     printf("✓ Livox SDK initialized\n");
@@ -893,6 +2115,12 @@ int main(int argc, char** argv) {
     SetLivoxLidarInfoChangeCallback(LidarInfoChangeCallback, nullptr);
     SetLivoxLidarPointCloudCallBack(PointCloudCallback, nullptr);
 
+    // Fast start: the deferred banner I/O happens after the pipeline is
+    // live, so it never delays the first packet
+    if (g_fast_start) {
+        print_config_banner(config_file, target_ip, target_port);
+    }
+
     printf("\n🚀 Streaming started...\n");
     printf("Press Ctrl+C to stop\n\n");
 
@@ -918,12 +2146,22 @@ int main(int argc, char** argv) {
     printf("3. Uninitializing Livox SDK...\n");
     LivoxLidarSdkUninit();
 
-    // Step 4: Close UDP socket (after callbacks stopped)
-    printf("4. Closing UDP socket...\n");
-    if (udp_socket >= 0) {
-        close(udp_socket);
-        udp_socket = -1;
+    // Step 4: Drain ring and stop sender thread
+    printf("4. Draining transmit ring...\n");
+    sender_running.store(false, std::memory_order_relaxed);
+    if (sender_thread.joinable()) {
+        sender_thread.join();
+    }
+
+    // Step 5: Close UDP socket and telemetry endpoint (after sender stopped;
+    // the echo listener must exit before its fd goes away)
+    printf("5. Closing UDP socket...\n");
+    if (echo_thread.joinable()) {
+        echo_running.store(false, std::memory_order_relaxed);
+        echo_thread.join();
     }
+    g_telemetry.stop();
+    g_sender.close();
 
     printf("✓ Shutdown sequence complete\n\n");
 
@@ -949,24 +2187,122 @@ int main(int argc, char** argv) {
     printf("  Segmented points:    %lu\n", stats_points_segmented.load(std::memory_order_relaxed));
     printf("  Dropped (cap):       %lu ⚠\n", stats_points_dropped_cap.load(std::memory_order_relaxed));
 
+    uint64_t flushes = stats_flush_count.load(std::memory_order_relaxed);
+    uint64_t flush_segs = stats_flush_segments.load(std::memory_order_relaxed);
+    printf("\nBatched TX (sendmmsg):\n");
+    printf("  Flushes:             %lu%s\n", flushes,
+           g_sender.sendmmsg_unavailable() ? " (fallback: sendto loop)" : "");
+    printf("  Segments/flush avg:  %.1f\n", flushes > 0 ? (double)flush_segs / flushes : 0.0);
+    printf("  Segments/flush max:  %u\n", stats_flush_max_batch.load(std::memory_order_relaxed));
+
+    if (g_compress) {
+        uint64_t comp_pkts = stats_compressed_packets.load(std::memory_order_relaxed);
+        uint64_t comp_raw = stats_compress_fallbacks.load(std::memory_order_relaxed);
+        uint64_t comp_saved = stats_compress_saved_bytes.load(std::memory_order_relaxed);
+        uint64_t comp_us = stats_compress_time_us.load(std::memory_order_relaxed);
+        double avg_us = (comp_pkts + comp_raw) > 0
+            ? (double)comp_us / (comp_pkts + comp_raw) : 0.0;
+
+        printf("\nCompression (LZ4):\n");
+        printf("  Compressed packets:  %lu\n", comp_pkts);
+        printf("  Raw fallbacks:       %lu\n", comp_raw);
+        printf("  Bytes saved:         %lu (%.2f MB)\n", comp_saved, comp_saved / 1048576.0);
+        printf("  Avg time/packet:     %.1f µs%s\n", avg_us,
+               avg_us > 50.0 ? " ⚠ (budget 50)" : "");
+    }
+
+    if (g_fec_k > 0) {
+        uint64_t parity_pkts = stats_fec_parity_packets.load(std::memory_order_relaxed);
+        uint64_t parity_bytes = stats_fec_parity_bytes.load(std::memory_order_relaxed);
+
+        printf("\nFEC (XOR parity, k=%d):\n", g_fec_k);
+        printf("  Parity packets:      %lu\n", parity_pkts);
+        printf("  Parity bytes:        %lu (%.2f MB)\n", parity_bytes,
+               parity_bytes / 1048576.0);
+        printf("  Overhead:            %.1f%%\n",
+               total_bytes > parity_bytes
+                   ? 100.0 * parity_bytes / (total_bytes - parity_bytes) : 0.0);
+    }
+
+    if (g_latency_probe) {
+        uint64_t echoes = stats_echoes_received.load(std::memory_order_relaxed);
+        uint64_t best_rtt = stats_echo_best_rtt_ns.load(std::memory_order_relaxed);
+
+        printf("\nLatency Probe:\n");
+        printf("  Echoes received:     %lu\n", echoes);
+        if (echoes > 0) {
+            printf("  RTT p50/p95/p99:     %.3f / %.3f / %.3f ms\n",
+                   hist_echo_rtt->percentile_us(0.50) / 1000.0,
+                   hist_echo_rtt->percentile_us(0.95) / 1000.0,
+                   hist_echo_rtt->percentile_us(0.99) / 1000.0);
+            printf("  Best RTT:            %.3f ms\n", best_rtt / 1e6);
+            printf("  Clock offset:        %+.3f ms (rx - tx, at best RTT)\n",
+                   stats_echo_offset_ns.load(std::memory_order_relaxed) / 1e6);
+        }
+    }
+
+    printf("\nTransmit Pipeline:\n");
+    printf("  Ring batches:        %lu\n", stats_ring_batches.load(std::memory_order_relaxed));
+    printf("  Ring high-water:     %u / %d slots\n",
+           stats_ring_hwm.load(std::memory_order_relaxed), TX_RING_SIZE);
+    printf("  Producer overruns:   %lu%s\n",
+           stats_ring_overruns.load(std::memory_order_relaxed),
+           stats_ring_overruns.load(std::memory_order_relaxed) > 0 ? " ⚠" : "");
+
+    if (g_budget_pps > 0) {
+        printf("\nBudgeted Selection:\n");
+        printf("  Target:              %d pts/s over %d sectors\n",
+               g_budget_pps, BUDGET_SECTORS);
+        printf("  Budget dropped:      %lu\n",
+               stats_budget_dropped.load(std::memory_order_relaxed));
+    }
+
+    if (g_adaptive) {
+        printf("\nAdaptive Downsample:\n");
+        printf("  Final factor:        1/%d (configured 1/%d)\n",
+               g_adapt_factor.load(std::memory_order_relaxed), g_downsample);
+        printf("  Backoffs:            %lu\n",
+               stats_adapt_backoffs.load(std::memory_order_relaxed));
+        printf("  Recoveries:          %lu\n",
+               stats_adapt_recoveries.load(std::memory_order_relaxed));
+    }
+
     printf("\nErrors:\n");
     printf("  Dropped packets:     %lu\n", stats_dropped_packets.load(std::memory_order_relaxed));
     printf("  EAGAIN count:        %lu\n", stats_send_eagain.load(std::memory_order_relaxed));
     printf("  Filtered points:     %lu\n", stats_filtered_points.load(std::memory_order_relaxed));
     printf("  Seq wraps:           %u\n", stats_seq_wraps.load(std::memory_order_relaxed));
+    printf("  Hot-path allocs:     %lu%s\n",
+           stats_packet_allocs.load(std::memory_order_relaxed),
+           stats_packet_allocs.load(std::memory_order_relaxed) > 0 ? " ⚠ (expected 0)" : "");
 
     printf("\nTimestamp:\n");
     printf("  Using fallback:      %s\n", ts_using_fallback ? "YES ⚠" : "no");
 
-    double ts_mean, ts_stddev;
-    calc_ts_stats(&ts_mean, &ts_stddev);
-    printf("  Δt mean:             %.3f ms\n", ts_mean);
-    printf("  Δt stddev:           %.3f ms\n", ts_stddev);
+    printf("  Δt mean:             %.3f ms\n", ts_delta_stats.mean_ms());
+    printf("  Δt stddev:           %.3f ms\n", ts_delta_stats.stddev_ms());
+    printf("  Δt min/max:          %.3f / %.3f ms\n",
+           ts_delta_stats.min_ms(), ts_delta_stats.max_ms());
+    printf("  Δt p50/p95/p99:      %.3f / %.3f / %.3f ms\n",
+           hist_ts_delta->percentile_us(0.50) / 1000.0,
+           hist_ts_delta->percentile_us(0.95) / 1000.0,
+           hist_ts_delta->percentile_us(0.99) / 1000.0);
+
+    printf("\nStage Latencies:\n");
+    latency::HistogramRegistry::instance().dump(STDOUT_FILENO);
 
     printf("\nConfiguration:\n");
     printf("  CRC32 enabled:       %d\n", g_crc_enabled ? 1 : 0);
     printf("  Range:               %.1f - %.1f m\n", g_min_range, g_max_range);
-    printf("  Downsample:          1/%d\n", g_downsample);
+    if (g_z_min > -INFINITY || g_z_max < INFINITY) {
+        printf("  Z band:              %.2f - %.2f m\n", g_z_min, g_z_max);
+    }
+    if (g_budget_pps > 0) {
+        printf("  Budget:              %d pts/s\n", g_budget_pps);
+    } else {
+        printf("  Downsample:          1/%d%s\n", g_downsample,
+               g_adaptive ? " (adaptive)" : "");
+    }
 
     printf("━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n");
 
@@ -5,6 +5,9 @@
 #include <cstdint>
 #include <string>
 #include <optional>
+#include <map>
+#include <memory>
+#include <unordered_set>
 
 // Frame Builder - Time-based Point Cloud Accumulator
 //
@@ -20,6 +23,14 @@ struct Frame;
 struct FrameBuilderStats;
 class FrameBuilder;
 
+// Occupancy grid geometry: a fixed OCC_GRID_DIM^3 cube of cells centered
+// on the sensor origin; the cell size is configurable per builder. 32^3
+// bits = 4 KB per frame, cheap enough to rebuild every frame and ship
+// across the pybind boundary alongside the points.
+constexpr int OCC_GRID_DIM = 32;
+constexpr size_t OCC_GRID_WORDS =
+    static_cast<size_t>(OCC_GRID_DIM) * OCC_GRID_DIM * OCC_GRID_DIM / 64;
+
 // ============================================================================
 // Frame - Point cloud frame with metadata
 // ============================================================================
@@ -28,6 +39,16 @@ struct Frame {
     std::vector<float> xyz_data;    // Flat array: [x0,y0,z0, x1,y1,z1, ...]
     size_t point_count;             // Number of points
 
+    // Structure-of-arrays channels (SoA mode only; xyz_data stays empty).
+    // Separate contiguous arrays avoid the Python-side deinterleave that
+    // reflectivity features otherwise pay for, and keep the intensity
+    // channel that interleaved accumulation drops.
+    bool soa = false;
+    std::vector<float> x_data;
+    std::vector<float> y_data;
+    std::vector<float> z_data;
+    std::vector<float> intensity_data;
+
     int64_t start_ts_ns;            // Frame start timestamp (nanoseconds)
     int64_t end_ts_ns;              // Frame end timestamp (nanoseconds)
 
@@ -36,6 +57,21 @@ struct Frame {
 
     uint32_t pkt_count;             // Number of packets in frame
 
+    uint16_t sensor_id = 0;         // Source sensor (0 = primary)
+
+    // Spatial metadata, maintained incrementally at accumulation time so
+    // consumers (viewer culling, nearest-neighbor association, obstacle
+    // checks) do not each re-scan the flat arrays per frame
+    float aabb_min[3] = {0, 0, 0};  // Axis-aligned bounds (meters)
+    float aabb_max[3] = {0, 0, 0};
+    float centroid[3] = {0, 0, 0};  // Mean of accumulated points
+
+    // Coarse occupancy bitmask: OCC_GRID_DIM^3 bits, x-major, over a cube
+    // of occ_cell_size cells centered on the origin (out-of-range points
+    // clamp to border cells). Empty when the grid is disabled.
+    float occ_cell_size = 0.0f;     // Cell edge length (0 = no grid)
+    std::vector<uint64_t> occupancy;
+
     // Helper: frame duration in seconds
     double duration_s() const {
         return (end_ts_ns - start_ts_ns) / 1e9;
@@ -58,6 +94,15 @@ struct FrameBuilderStats {
     uint64_t seq_gaps = 0;          // Detected sequence gaps
     uint64_t seq_reorders = 0;      // Out-of-order packets
     uint64_t overflow_frames = 0;   // Frames exceeding max_frame_points
+    uint64_t voxel_dropped = 0;     // Points dropped by the voxel filter
+    uint64_t deskewed_points = 0;   // Points re-projected by the de-skew stage
+
+    // Profiling counters (per-instance so parallel builders do not mix;
+    // single-writer, read unsynchronized like the rest)
+    uint64_t add_to_frame_calls = 0;
+    uint64_t close_frame_calls = 0;
+    uint64_t memcpy_calls = 0;
+    uint64_t memcpy_bytes = 0;
 
     // Reset all counters
     void reset();
@@ -73,9 +118,19 @@ struct FrameBuilderStats {
 class FrameBuilder {
 public:
     // Constructor
+    // voxel_size > 0 enables incremental voxel-grid downsampling: only the
+    // first point landing in each voxel is accumulated, so frames are
+    // reduced before they ever cross the pybind boundary
+    // soa = true accumulates separate x/y/z/intensity channels instead of
+    // interleaved triplets (emitted via Frame::x_data etc.)
+    // occupancy_cell_size > 0 additionally maintains a coarse occupancy
+    // bitmask per frame (see Frame::occupancy)
     FrameBuilder(double frame_period_s,
                  size_t max_frame_points,
-                 FrameBuilderStats& stats);
+                 FrameBuilderStats& stats,
+                 double voxel_size = 0.0,
+                 bool soa = false,
+                 double occupancy_cell_size = 0.0);
 
     // Destructor
     ~FrameBuilder() = default;
@@ -90,6 +145,17 @@ public:
         bool debug = false
     );
 
+    // Add packet with a per-point intensity channel (contiguous, N floats;
+    // nullptr zero-fills). Intensity is only retained in SoA mode.
+    std::optional<Frame> add_packet(
+        int64_t device_ts_ns,
+        const float* xyz_data,
+        const float* intensity_data,
+        size_t point_count,
+        uint32_t seq,
+        bool debug = false
+    );
+
     // Add batch of packets (returns all completed frames)
     std::vector<Frame> add_packets_batch(
         const int64_t* device_ts_ns_batch,
@@ -106,19 +172,53 @@ public:
     // Reset state
     void reset();
 
+    // Sensor identity (stamped onto emitted frames; 0 = primary)
+    void set_sensor_id(uint16_t sensor_id) { sensor_id_ = sensor_id; }
+    uint16_t sensor_id() const { return sensor_id_; }
+
+    // Motion compensation: supply the current body twist (sensor frame;
+    // linear velocity in m/s, yaw rate in rad/s). While a twist is set,
+    // close_current_frame() linearly re-projects every point to the
+    // frame-end timestamp using the per-packet capture times, undoing the
+    // ~v * frame_period smear a moving platform puts on the cloud.
+    // Update per frame as the estimate changes; clear_twist() disables.
+    void set_twist(float vx, float vy, float vz, float wz);
+    void clear_twist();
+
     // Get statistics (const reference to avoid copies)
     const FrameBuilderStats& stats() const { return stats_; }
 
 private:
+    // Per-channel accumulation buffers (SoA mode)
+    struct SoABuffers {
+        std::vector<float> x, y, z, intensity;
+
+        void reserve(size_t n) {
+            x.reserve(n); y.reserve(n); z.reserve(n); intensity.reserve(n);
+        }
+        void clear() {
+            x.clear(); y.clear(); z.clear(); intensity.clear();
+        }
+    };
+
     // Configuration
     int64_t frame_period_ns_;       // Frame period in nanoseconds
     size_t max_frame_points_;       // Maximum points per frame
+    float voxel_size_;              // Voxel leaf size in meters (0 = disabled)
+    float inv_voxel_size_;          // Precomputed 1/voxel_size_
+    bool soa_;                      // Structure-of-arrays accumulation
+    float occ_cell_size_;           // Occupancy cell size (0 = disabled)
+    float inv_occ_cell_;            // Precomputed 1/occ_cell_size_
 
     // Statistics reference (shared with Python)
     FrameBuilderStats& stats_;
 
-    // Current frame state
+    // Current frame state (double-buffered: the full buffer is moved into
+    // the outgoing Frame at close while accumulation continues into the spare)
     std::vector<float> point_buffer_;   // Pre-allocated buffer (max_frame_points * 3)
+    std::vector<float> spare_buffer_;   // Pre-allocated standby buffer
+    SoABuffers soa_buffer_;             // Per-channel buffers (SoA mode)
+    SoABuffers soa_spare_;              // Standby channels (SoA mode)
     size_t current_point_count_;        // Current fill level
 
     int64_t current_frame_start_ts_;    // Frame start timestamp (-1 if no frame)
@@ -130,24 +230,151 @@ private:
 
     std::optional<uint32_t> last_seq_;  // Last seen sequence (for gap detection)
 
+    uint16_t sensor_id_ = 0;            // Stamped onto emitted frames
+
+    // Spatial hash of occupied voxels for the current frame (voxel mode only)
+    std::unordered_set<uint64_t> voxel_set_;
+
+    // Per-packet accumulation spans for de-skew: first kept-point index
+    // and capture timestamp (recorded only while a twist is set)
+    struct PacketSpan {
+        size_t begin;
+        int64_t ts_ns;
+    };
+    std::vector<PacketSpan> packet_spans_;
+
+    // De-skew twist (sensor frame; applied while deskew_ is true)
+    bool deskew_ = false;
+    float twist_vx_ = 0.0f;
+    float twist_vy_ = 0.0f;
+    float twist_vz_ = 0.0f;
+    float twist_wz_ = 0.0f;
+
+    // Running spatial metadata for the current frame (folded in per point;
+    // the centroid sum is double so 10^5 points do not drift)
+    float aabb_min_[3];
+    float aabb_max_[3];
+    double centroid_sum_[3];
+    std::vector<uint64_t> occupancy_;   // Current frame's bitmask
+
     // Internal helpers
     std::optional<Frame> close_current_frame(bool debug);
     void add_to_current_frame(
         int64_t device_ts_ns,
         const float* xyz_data,
+        const float* intensity_data,
         size_t point_count,
         uint32_t seq,
         bool debug
     );
     void start_new_frame(int64_t device_ts_ns, uint32_t seq);
 
+    // Spatial metadata helpers: batch form for contiguous xyz triplets
+    // (vectorizable), per-point form for the SoA accumulation loop
+    void update_spatial_metadata(const float* xyz_data, size_t point_count);
+    void update_point_metadata(float x, float y, float z);
+
+    // Re-project a closed frame's points to its end timestamp (de-skew)
+    void deskew_frame(Frame& frame);
+
     // Sequence tracking helpers
     bool is_sequence_gap(uint32_t current_seq, uint32_t last_seq) const;
     bool is_sequence_reorder(uint32_t current_seq, uint32_t last_seq) const;
 };
 
-// Profiling utilities
-void print_profiling_stats();
+// ============================================================================
+// MultiSensorFrameBuilder - Per-sensor demultiplexing
+// ============================================================================
+//
+// Routes packets to an independent FrameBuilder per sensor_id so multi-LiDAR
+// rigs can share one receiver without interleaving timestamps across sensors
+// (which corrupts the per-sensor frame windows). Each sensor gets its own
+// pre-allocated buffer, sequence tracking, and FrameBuilderStats; emitted
+// frames carry the originating sensor_id.
+
+class MultiSensorFrameBuilder {
+public:
+    // Constructor (per-sensor builders are created lazily on first packet)
+    MultiSensorFrameBuilder(double frame_period_s, size_t max_frame_points,
+                            double voxel_size = 0.0, bool soa = false,
+                            double occupancy_cell_size = 0.0);
+
+    // Add packet for a specific sensor
+    // Returns that sensor's completed frame if its window expired
+    std::optional<Frame> add_packet(
+        uint16_t sensor_id,
+        int64_t device_ts_ns,
+        const float* xyz_data,
+        size_t point_count,
+        uint32_t seq,
+        bool debug = false
+    );
+
+    // Add packet with a per-point intensity channel (SoA mode)
+    std::optional<Frame> add_packet(
+        uint16_t sensor_id,
+        int64_t device_ts_ns,
+        const float* xyz_data,
+        const float* intensity_data,
+        size_t point_count,
+        uint32_t seq,
+        bool debug = false
+    );
+
+    // Flush all sensors' remaining frames (on shutdown)
+    std::vector<Frame> flush(bool debug = false);
+
+    // Reset all per-sensor state
+    void reset();
+
+    // Sensors seen so far
+    std::vector<uint16_t> sensor_ids() const;
+    size_t sensor_count() const { return sensors_.size(); }
+
+    // Per-sensor statistics (nullptr if the sensor has not been seen)
+    const FrameBuilderStats* stats_for(uint16_t sensor_id) const;
+
+    // Motion compensation twist, applied to every sensor's builder
+    // (including ones created later); see FrameBuilder::set_twist()
+    void set_twist(float vx, float vy, float vz, float wz);
+    void clear_twist();
+
+private:
+    // Per-sensor accumulation state (stats must outlive the builder)
+    struct SensorState {
+        FrameBuilderStats stats;
+        FrameBuilder builder;
+
+        SensorState(double frame_period_s, size_t max_frame_points,
+                    uint16_t sensor_id, double voxel_size, bool soa,
+                    double occupancy_cell_size)
+            : stats(), builder(frame_period_s, max_frame_points, stats,
+                               voxel_size, soa, occupancy_cell_size) {
+            builder.set_sensor_id(sensor_id);
+        }
+    };
+
+    SensorState& get_or_create(uint16_t sensor_id);
+
+    double frame_period_s_;
+    size_t max_frame_points_;
+    double voxel_size_;
+    bool soa_;
+    double occupancy_cell_size_;
+
+    // Twist replayed onto lazily-created builders
+    bool deskew_ = false;
+    float twist_vx_ = 0.0f;
+    float twist_vy_ = 0.0f;
+    float twist_vz_ = 0.0f;
+    float twist_wz_ = 0.0f;
+
+    std::map<uint16_t, std::unique_ptr<SensorState>> sensors_;
+};
+
+// Profiling utilities (counters come from one builder's stats; the stage
+// latency histograms are process-wide)
+void print_profiling_stats(const FrameBuilderStats& stats);
 
 } // namespace frame_builder
 
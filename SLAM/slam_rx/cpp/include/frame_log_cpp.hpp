@@ -0,0 +1,168 @@
+#ifndef FRAME_LOG_CPP_HPP
+#define FRAME_LOG_CPP_HPP
+
+#include "frame_builder_cpp.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Frame Log - Memory-mapped append-only frame recording
+//
+// Records completed frames (metadata + xyz payload) to a chunked,
+// memory-mapped binary log so field runs can be replayed through the
+// SLAM pipeline far faster than realtime. A sidecar index file
+// (start timestamp -> record offset) makes seeking O(log n); the reader
+// maps the whole log read-only and serves frames as zero-copy views
+// into the mapping.
+//
+// Layout: LogFileHeader, then FrameRecordHeader + float32 xyz payload
+// per frame, back to back. All fields little-endian, 4-byte aligned.
+
+namespace frame_log {
+
+// ============================================================================
+// On-disk format
+// ============================================================================
+
+constexpr uint32_t LOG_MAGIC = 0x474C464C;     // "LFLG"
+constexpr uint32_t LOG_VERSION = 1;
+constexpr uint32_t RECORD_MAGIC = 0x4D415246;  // "FRAM"
+
+// File growth granularity: ftruncate + remap once per chunk, not per frame
+constexpr size_t LOG_CHUNK_BYTES = 16 * 1024 * 1024;
+
+#pragma pack(push, 1)
+struct LogFileHeader {
+    uint32_t magic;        // LOG_MAGIC
+    uint32_t version;      // LOG_VERSION
+    uint64_t reserved;     // Future use (0)
+};
+
+struct FrameRecordHeader {
+    uint32_t magic;        // RECORD_MAGIC
+    uint32_t point_count;  // Number of xyz triples following
+    int64_t start_ts_ns;   // Frame start timestamp (nanoseconds)
+    int64_t end_ts_ns;     // Frame end timestamp
+    uint32_t seq_first;    // First packet sequence number
+    uint32_t seq_last;     // Last packet sequence number
+    uint32_t pkt_count;    // Packets in frame
+    uint16_t sensor_id;    // Source sensor
+    uint16_t reserved;     // Future use (0)
+};
+
+// Sidecar index record ("<log path>.idx", one per frame, in file order)
+struct IndexEntry {
+    int64_t start_ts_ns;   // Frame start timestamp
+    uint64_t offset;       // Record offset in the log file
+};
+#pragma pack(pop)
+
+static_assert(sizeof(LogFileHeader) == 16, "LogFileHeader must be 16 bytes");
+static_assert(sizeof(FrameRecordHeader) == 40, "FrameRecordHeader must be 40 bytes");
+static_assert(sizeof(IndexEntry) == 16, "IndexEntry must be 16 bytes");
+
+// ============================================================================
+// FrameLogWriter - Append-only memory-mapped writer
+// ============================================================================
+
+class FrameLogWriter {
+public:
+    // Constructor (does not touch the filesystem; call open())
+    explicit FrameLogWriter(const std::string& path);
+
+    // Destructor (closes the log if open)
+    ~FrameLogWriter();
+
+    // Non-copyable (owns fd and mapping)
+    FrameLogWriter(const FrameLogWriter&) = delete;
+    FrameLogWriter& operator=(const FrameLogWriter&) = delete;
+
+    // Create/truncate the log file and map the first chunk
+    // Returns false on filesystem errors
+    bool open();
+
+    // Append one completed frame (SoA frames are re-interleaved into the
+    // record's xyz triplet layout via a reused scratch buffer)
+    void append(const frame_builder::Frame& frame);
+
+    // Append from raw metadata + xyz pointer (zero-copy from callers
+    // that do not hold a Frame, e.g. the pybind wrapper)
+    void append_raw(int64_t start_ts_ns, int64_t end_ts_ns,
+                    uint32_t seq_first, uint32_t seq_last,
+                    uint32_t pkt_count, uint16_t sensor_id,
+                    const float* xyz, size_t point_count);
+
+    // Unmap, truncate to the written size, write the sidecar index
+    void close();
+
+    bool is_open() const { return fd_ >= 0; }
+    uint64_t frames_written() const { return index_.size(); }
+    uint64_t bytes_written() const { return write_offset_; }
+    const std::string& path() const { return path_; }
+
+private:
+    // Grow the file/mapping so record_size more bytes fit
+    bool ensure_capacity(size_t record_size);
+
+    std::string path_;
+    int fd_ = -1;
+    uint8_t* map_ = nullptr;
+    size_t capacity_ = 0;       // Mapped/truncated size
+    size_t write_offset_ = 0;   // Next append position
+
+    std::vector<IndexEntry> index_;
+    std::vector<float> interleave_;  // Scratch for SoA-frame appends
+};
+
+// ============================================================================
+// FrameLogReader - Read-only mmap replay
+// ============================================================================
+
+class FrameLogReader {
+public:
+    // Constructor (does not touch the filesystem; call open())
+    explicit FrameLogReader(const std::string& path);
+
+    // Destructor (closes the mapping if open)
+    ~FrameLogReader();
+
+    // Non-copyable (owns fd and mapping)
+    FrameLogReader(const FrameLogReader&) = delete;
+    FrameLogReader& operator=(const FrameLogReader&) = delete;
+
+    // Map the log read-only; loads the sidecar index if present,
+    // otherwise rebuilds it by scanning the records
+    bool open();
+
+    void close();
+
+    bool is_open() const { return map_ != nullptr; }
+    size_t frame_count() const { return index_.size(); }
+    const std::string& path() const { return path_; }
+
+    // Record header for frame i (nullptr if out of range)
+    const FrameRecordHeader* record(size_t i) const;
+
+    // Pointer into the mapping at frame i's xyz payload
+    // Valid until close(); zero-copy
+    const float* xyz(size_t i) const;
+
+    // Index of the first frame with start_ts_ns >= ts (frame_count() if none)
+    size_t lower_bound_ts(int64_t ts) const;
+
+private:
+    // Rebuild the in-memory index by walking the records
+    bool scan_records();
+
+    std::string path_;
+    int fd_ = -1;
+    const uint8_t* map_ = nullptr;
+    size_t size_ = 0;
+
+    std::vector<IndexEntry> index_;
+};
+
+} // namespace frame_log
+
+#endif // FRAME_LOG_CPP_HPP
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <vector>
 #include <string>
 #include <optional>
@@ -12,6 +13,38 @@ constexpr size_t HEADER_SIZE = 27;
 constexpr size_t POINT_SIZE = 13;
 constexpr size_t MAX_POINTS_PER_PACKET = 105;
 
+// Protocol v2: quantized 16-bit points (selected per-packet via flags bit 0)
+constexpr uint16_t FLAG_QUANT_POINTS = 0x0001;
+constexpr size_t QUANT_BLOCK_SIZE = 16;   // offset[3] + scale (4 floats)
+constexpr size_t QUANT_POINT_SIZE = 7;    // x, y, z int16 + intensity uint8
+constexpr size_t MAX_QUANT_POINTS_PER_PACKET = 193;
+
+// Optional LZ4 payload compression (selected per-packet via flags bit 1)
+constexpr uint16_t FLAG_COMPRESSED_LZ4 = 0x0002;
+constexpr size_t MAX_UDP_PAYLOAD = 1400;
+
+// Optional XOR parity FEC (selected per-packet via flags bit 2).
+// A parity packet protects the k data packets seq..seq+k-1: its payload is
+// a FecBlock followed by the XOR of their point payloads (zero-padded to
+// the longest), and its header carries seq = first protected seq,
+// device_ts_ns = XOR of their timestamps, point_count = XOR byte length.
+// Any single lost group member is rebuilt by XORing the parity payload
+// with the members that did arrive.
+constexpr uint16_t FLAG_FEC_PARITY = 0x0004;
+constexpr size_t FEC_BLOCK_SIZE = 8;
+constexpr size_t FEC_MAX_K = 16;
+constexpr size_t FEC_WINDOW = 32;   // Buffered recent datagrams (power of two)
+
+// Latency probe (selected per-packet via flags bit 3). The sender appends
+// its host send time (CLOCK_MONOTONIC ns, little-endian uint64) as an
+// 8-byte trailer after the point payload; it is covered by the CRC and
+// stripped before point decoding. The receiver may echo a sample of these
+// back to the datagram source as LatencyEcho packets so the sender can
+// build RTT histograms and estimate the tx/rx clock offset.
+constexpr uint16_t FLAG_HOST_TS = 0x0008;
+constexpr size_t HOST_TS_TRAILER_SIZE = 8;
+constexpr uint32_t ECHO_MAGIC = 0x4C495645;  // "LIVE"
+
 // Packed header structure (little-endian)
 #pragma pack(push, 1)
 struct PacketHeader {
@@ -38,6 +71,51 @@ struct Point {
 
 static_assert(sizeof(Point) == POINT_SIZE, "Point must be 13 bytes");
 
+// Quantization block preceding v2 point data (coordinate = offset + q * scale)
+#pragma pack(push, 1)
+struct QuantBlock {
+    float offset_x, offset_y, offset_z;  // per-axis packet midpoint (meters)
+    float scale;                         // meters per LSB
+};
+#pragma pack(pop)
+
+static_assert(sizeof(QuantBlock) == QUANT_BLOCK_SIZE, "QuantBlock must be 16 bytes");
+
+// Quantized point (7 bytes: 3 int16 + 1 byte)
+#pragma pack(push, 1)
+struct QuantPoint {
+    int16_t x, y, z;
+    uint8_t intensity;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(QuantPoint) == QUANT_POINT_SIZE, "QuantPoint must be 7 bytes");
+
+// FEC block preceding the XOR bytes in a parity packet
+#pragma pack(push, 1)
+struct FecBlock {
+    uint8_t k;                 // Protected group size (2..FEC_MAX_K)
+    uint8_t reserved;          // Zero
+    uint16_t xor_point_count;  // XOR of protected point_count fields
+    uint16_t xor_flags;        // XOR of protected flags fields
+    uint16_t xor_len;          // XOR of protected payload lengths (bytes)
+};
+#pragma pack(pop)
+
+static_assert(sizeof(FecBlock) == FEC_BLOCK_SIZE, "FecBlock must be 8 bytes");
+
+// Latency echo returned to the sender for a sampled FLAG_HOST_TS packet
+#pragma pack(push, 1)
+struct LatencyEcho {
+    uint32_t magic;         // ECHO_MAGIC
+    uint32_t seq;           // Sequence number of the sampled packet
+    uint64_t host_send_ns;  // Sender host time, echoed from the trailer
+    uint64_t rx_recv_ns;    // Receiver host time at receipt
+};
+#pragma pack(pop)
+
+static_assert(sizeof(LatencyEcho) == 24, "LatencyEcho must be 24 bytes");
+
 // Statistics tracking
 class ProtocolStats {
 public:
@@ -48,15 +126,41 @@ public:
     int bad_version = 0;
     int len_mismatch = 0;
     int invalid_count = 0;
+    int compressed_packets = 0;
+    int decompress_failures = 0;
+    int fec_parity_packets = 0;
+    int fec_recovered = 0;
+    int fec_unrecoverable = 0;
 
     void reset() {
         total_packets = valid_packets = crc_failures = 0;
         bad_magic = bad_version = len_mismatch = invalid_count = 0;
+        compressed_packets = decompress_failures = 0;
+        fec_parity_packets = fec_recovered = fec_unrecoverable = 0;
     }
 
     std::string repr() const;
 };
 
+// Batch parse result: concatenated points for a whole datagram burst.
+// Invalid datagrams are skipped (counted in ProtocolStats); metadata
+// vectors hold one entry per *valid* packet, in burst order.
+struct ParsedBatch {
+    size_t packet_count = 0;            // Valid packets in the batch
+    size_t total_points = 0;            // Sum of their point counts
+
+    // Concatenated point data across all valid packets
+    std::vector<float> points_data;     // (total_points, 4) - x, y, z, intensity
+    std::vector<float> xyz_data;        // (total_points, 3) - x, y, z only
+
+    // Per-packet metadata (parallel arrays)
+    std::vector<uint64_t> device_ts_ns;
+    std::vector<uint32_t> seq;
+    std::vector<uint16_t> point_counts;
+    std::vector<uint16_t> sensor_ids;
+    std::vector<uint64_t> host_send_ns;  // FLAG_HOST_TS trailer (0 = none)
+};
+
 // Parsed packet result
 struct ParsedPacket {
     uint64_t device_ts_ns;
@@ -65,6 +169,7 @@ struct ParsedPacket {
     uint16_t sensor_id;
     uint16_t flags;
     uint32_t crc32;
+    uint64_t host_send_ns = 0;  // FLAG_HOST_TS trailer (0 = not present)
 
     // points: (N, 4) - x, y, z, intensity
     std::vector<float> points_data;
@@ -85,6 +190,15 @@ public:
         bool debug = false
     );
 
+    // Parse a burst of datagrams into one concatenated result
+    // (one call per recvmmsg burst instead of one per packet)
+    ParsedBatch parse_datagrams(
+        const uint8_t* const* datagrams,
+        const size_t* lengths,
+        size_t count,
+        bool debug = false
+    );
+
     // CRC32 IEEE 802.3 calculation
     uint32_t crc32_ieee(const uint8_t* data, size_t length);
 
@@ -96,6 +210,60 @@ private:
     bool validate_crc_;
     ProtocolStats stats_;
 
+    // FEC recovery state: copies of recent data datagrams, indexed by
+    // seq & (FEC_WINDOW - 1). Allocated on the first parity packet so a
+    // stream without FEC never pays the per-packet copy.
+    struct FecSlot {
+        bool valid = false;
+        uint32_t seq = 0;
+        uint16_t length = 0;
+        uint8_t data[MAX_UDP_PAYLOAD];
+    };
+    std::unique_ptr<FecSlot[]> fec_window_;
+
+    // Buffer a validated data datagram for FEC recovery (no-op until the
+    // first parity packet has been seen)
+    void fec_store(const PacketHeader* header, const uint8_t* data, size_t length);
+
+    // Process a validated parity packet. If exactly one packet of its
+    // group is missing from the window, reconstructs that datagram into
+    // out (MAX_UDP_PAYLOAD bytes) and returns its length; 0 otherwise.
+    size_t fec_process_parity(
+        const PacketHeader* header,
+        const uint8_t* data,
+        uint8_t* out,
+        bool debug
+    );
+
+    // Shared header/length/CRC validation (updates stats_)
+    // Returns the header pointer, or nullptr if the datagram is invalid
+    const PacketHeader* validate_datagram(
+        const uint8_t* data,
+        size_t length,
+        bool debug
+    );
+
+    // Resolve the point payload for a validated datagram: passthrough for
+    // uncompressed packets, LZ4-decompress into scratch otherwise.
+    // Returns nullptr (and counts the failure) if decompression fails or
+    // this build lacks LZ4 support.
+    const uint8_t* decode_payload(
+        const PacketHeader* header,
+        const uint8_t* data,
+        size_t length,
+        uint8_t* scratch,
+        bool debug
+    );
+
+    // Decode the point payload (raw v1 floats or quantized v2 int16)
+    // and append onto the (N, 4) / (N, 3) arrays
+    void append_points(
+        const PacketHeader* header,
+        const uint8_t* payload,
+        std::vector<float>& points_data,
+        std::vector<float>& xyz_data
+    );
+
     // Hardware-accelerated CRC (if available)
 #ifdef HAVE_ARM_CRC32
     uint32_t crc32_hw_arm(const uint8_t* data, size_t length);
@@ -0,0 +1,196 @@
+#ifndef LIDAR_RX_CPP_HPP
+#define LIDAR_RX_CPP_HPP
+
+#include "lidar_protocol_cpp.hpp"
+#include "frame_builder_cpp.hpp"
+#include "frame_log_cpp.hpp"
+#include "telemetry.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Native RX Pipeline - UDP receive + parse + frame build in C++ threads
+//
+// Owns the sockets and runs receive -> LidarProtocol::parse_datagram ->
+// FrameBuilder::add_packet entirely off the Python interpreter. Completed
+// frames are handed to Python through a bounded queue, so Python wakes
+// once per frame (~10 Hz) instead of once per datagram (~4000/sec).
+//
+// Multi-sensor hosts pass several ports: each gets its own worker (socket
+// + receive thread + parser + frame builder), so three robot streams
+// parse in parallel on three cores instead of serializing on one thread.
+// Workers share nothing but the outgoing frame queue; stats are kept
+// per-worker and aggregated on demand.
+
+namespace lidar_rx {
+
+// ============================================================================
+// RxStats - Receive-side statistics
+// ============================================================================
+
+struct RxStats {
+    uint64_t datagrams_received = 0;    // Datagrams pulled off the socket
+    uint64_t bytes_received = 0;        // Total bytes received
+    uint64_t recv_timeouts = 0;         // Receive timeouts (idle link)
+    uint64_t frames_queued = 0;         // Frames handed to the queue
+    uint64_t queue_drops = 0;           // Frames dropped: Python not draining
+    uint64_t frames_recorded = 0;       // Frames appended to the frame log
+    uint64_t recvmmsg_calls = 0;        // Burst receive syscalls issued
+    uint64_t burst_max = 0;             // Largest burst from one recvmmsg()
+    uint64_t echoes_sent = 0;           // Latency echoes returned to the tx
+
+    // Reset all counters
+    void reset();
+
+    // String representation
+    std::string repr() const;
+};
+
+// ============================================================================
+// LidarReceiver - Socket + receive thread + frame queue
+// ============================================================================
+
+class LidarReceiver {
+public:
+    // Constructor (does not open the socket; call start())
+    // voxel_size > 0 enables voxel-grid downsampling inside the frame builder
+    // record_path != "" records every completed frame to a frame log
+    // telemetry_port > 0 serves JSON counter snapshots over UDP on that port
+    // echo_sample > 0 echoes every Nth latency-probe packet (FLAG_HOST_TS
+    // trailer) back to its source so the sender can measure RTT/offset
+    LidarReceiver(const std::string& bind_ip,
+                  uint16_t port,
+                  double frame_period_s,
+                  size_t max_frame_points,
+                  bool validate_crc,
+                  size_t queue_capacity,
+                  double voxel_size = 0.0,
+                  const std::string& record_path = "",
+                  int telemetry_port = 0,
+                  int echo_sample = 0);
+
+    // Multi-port constructor: one worker (socket + receive thread + parser
+    // + frame builder) per port, all bound on bind_ip
+    LidarReceiver(const std::string& bind_ip,
+                  std::vector<uint16_t> ports,
+                  double frame_period_s,
+                  size_t max_frame_points,
+                  bool validate_crc,
+                  size_t queue_capacity,
+                  double voxel_size = 0.0,
+                  const std::string& record_path = "",
+                  int telemetry_port = 0,
+                  int echo_sample = 0);
+
+    // Destructor (stops the receive thread if running)
+    ~LidarReceiver();
+
+    // Non-copyable (owns socket and thread)
+    LidarReceiver(const LidarReceiver&) = delete;
+    LidarReceiver& operator=(const LidarReceiver&) = delete;
+
+    // Open the sockets and start the receive threads
+    // Returns false if any socket could not be created/bound
+    bool start();
+
+    // Stop the receive threads, flush pending frames, close the sockets
+    void stop();
+
+    // Whether the receive threads are running
+    bool is_running() const { return running_.load(std::memory_order_relaxed); }
+
+    // Pop the next completed frame (blocks up to timeout_s)
+    // Returns nullopt on timeout or after stop() with an empty queue
+    std::optional<frame_builder::Frame> pop_frame(double timeout_s);
+
+    // Number of frames currently queued
+    size_t queue_depth();
+
+    // Statistics access (aggregated across workers; per-worker counters
+    // are single-writer and read unsynchronized, as stats() always has)
+    ProtocolStats protocol_stats() const;
+    frame_builder::FrameBuilderStats frame_stats() const;
+    RxStats rx_stats() const;
+
+    // Per-worker statistics access (index < worker_count())
+    size_t worker_count() const { return workers_.size(); }
+    uint16_t worker_port(size_t i) const { return workers_[i]->port; }
+    const ProtocolStats& protocol_stats(size_t i) const {
+        return workers_[i]->protocol.stats();
+    }
+    const frame_builder::FrameBuilderStats& frame_stats(size_t i) const {
+        return workers_[i]->fb_stats;
+    }
+    const RxStats& rx_stats(size_t i) const { return workers_[i]->rx_stats; }
+
+private:
+    // One worker per socket: its own parser and frame builder, so ports
+    // scale across cores with nothing shared but the frame queue
+    // (order matters: fb_stats before builder)
+    struct Worker {
+        uint16_t port;
+        int sock_fd = -1;
+        std::thread thread;
+        LidarProtocol protocol;
+        frame_builder::FrameBuilderStats fb_stats;
+        frame_builder::FrameBuilder builder;
+        RxStats rx_stats;
+
+        Worker(uint16_t port_arg, bool validate_crc, double frame_period_s,
+               size_t max_frame_points, double voxel_size)
+            : port(port_arg)
+            , protocol(validate_crc)
+            , fb_stats()
+            , builder(frame_period_s, max_frame_points, fb_stats, voxel_size)
+            , rx_stats()
+        {}
+    };
+
+    // Open and configure one worker's socket (false on failure)
+    bool open_socket(Worker& worker);
+
+    // Receive thread main loop (one per worker)
+    void rx_loop(Worker& worker);
+
+    // Enqueue a completed frame (drops the oldest frame when full)
+    void enqueue_frame(Worker& worker, frame_builder::Frame&& frame);
+
+    // Configuration
+    std::string bind_ip_;
+    size_t queue_capacity_;
+    std::string record_path_;
+    int telemetry_port_;
+    int echo_sample_;
+
+    // Workers (created in the constructor, threads started in start())
+    std::atomic<bool> running_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+
+    // Optional frame recording (created in start() when record_path_ is
+    // set; appends are serialized under queue_mutex_ since every worker
+    // can complete frames)
+    std::unique_ptr<frame_log::FrameLogWriter> recorder_;
+
+    // Optional telemetry endpoint (started when telemetry_port_ > 0);
+    // the snapshot reads the stats structs unsynchronized, same as stats()
+    telemetry::TelemetryServer telemetry_;
+
+    // Build one JSON counter snapshot into buf (telemetry callback)
+    size_t telemetry_snapshot(char* buf, size_t cap) const;
+
+    // Bounded frame queue (rx thread -> Python)
+    std::mutex queue_mutex_;
+    std::condition_variable queue_cv_;
+    std::deque<frame_builder::Frame> frame_queue_;
+};
+
+} // namespace lidar_rx
+
+#endif // LIDAR_RX_CPP_HPP
@@ -1,10 +1,13 @@
 #include "frame_builder_cpp.hpp"
+#include "latency_histogram.hpp"
+#include <algorithm>
 #include <cstring>
+#include <cmath>
 #include <iostream>
+#include <limits>
 #include <sstream>
 #include <iomanip>
 #include <chrono>
-#include <atomic>
 
 namespace frame_builder {
 
@@ -12,20 +15,20 @@ namespace frame_builder {
 // Profiling instrumentation
 // ============================================================================
 
-static std::atomic<size_t> g_memcpy_calls{0};
-static std::atomic<size_t> g_memcpy_bytes{0};
-static std::atomic<size_t> g_add_to_frame_calls{0};
-static std::atomic<size_t> g_close_frame_calls{0};
-static std::atomic<uint64_t> g_add_to_frame_total_us{0};
-static std::atomic<uint64_t> g_close_frame_total_us{0};
-static std::atomic<uint64_t> g_memcpy_total_us{0};
+// Log-bucketed latency histograms (shared registry with the rx loop's
+// parse stage; drops come from tail events, so means alone mislead)
+static latency::LatencyHistogram* const g_add_packet_hist =
+    latency::stage("add_packet");
+static latency::LatencyHistogram* const g_frame_close_hist =
+    latency::stage("frame_close");
+static latency::LatencyHistogram* const g_memcpy_hist =
+    latency::stage("fb_memcpy");
 
 #define PROFILE_START() auto _prof_start = std::chrono::high_resolution_clock::now()
-#define PROFILE_END(name, counter) \
+#define PROFILE_END(hist) \
     do { \
         auto _prof_end = std::chrono::high_resolution_clock::now(); \
-        auto _prof_dur_us = std::chrono::duration_cast<std::chrono::microseconds>(_prof_end - _prof_start).count(); \
-        counter += _prof_dur_us; \
+        (hist)->record_ns(std::chrono::duration_cast<std::chrono::nanoseconds>(_prof_end - _prof_start).count()); \
     } while(0)
 
 // ============================================================================
@@ -53,6 +56,12 @@ void FrameBuilderStats::reset() {
     seq_gaps = 0;
     seq_reorders = 0;
     overflow_frames = 0;
+    voxel_dropped = 0;
+    deskewed_points = 0;
+    add_to_frame_calls = 0;
+    close_frame_calls = 0;
+    memcpy_calls = 0;
+    memcpy_bytes = 0;
 }
 
 std::string FrameBuilderStats::repr() const {
@@ -63,7 +72,8 @@ std::string FrameBuilderStats::repr() const {
         << ", late=" << late_packets
         << ", gaps=" << seq_gaps
         << ", reorder=" << seq_reorders
-        << ", overflow=" << overflow_frames << ")";
+        << ", overflow=" << overflow_frames
+        << ", voxel_drop=" << voxel_dropped << ")";
     return oss.str();
 }
 
@@ -73,9 +83,18 @@ std::string FrameBuilderStats::repr() const {
 
 FrameBuilder::FrameBuilder(double frame_period_s,
                            size_t max_frame_points,
-                           FrameBuilderStats& stats)
+                           FrameBuilderStats& stats,
+                           double voxel_size,
+                           bool soa,
+                           double occupancy_cell_size)
     : frame_period_ns_(static_cast<int64_t>(frame_period_s * 1e9))
     , max_frame_points_(max_frame_points)
+    , voxel_size_(static_cast<float>(voxel_size))
+    , inv_voxel_size_(voxel_size > 0.0 ? static_cast<float>(1.0 / voxel_size) : 0.0f)
+    , soa_(soa)
+    , occ_cell_size_(static_cast<float>(occupancy_cell_size))
+    , inv_occ_cell_(occupancy_cell_size > 0.0
+                        ? static_cast<float>(1.0 / occupancy_cell_size) : 0.0f)
     , stats_(stats)
     , current_point_count_(0)
     , current_frame_start_ts_(-1)
@@ -85,13 +104,59 @@ FrameBuilder::FrameBuilder(double frame_period_s,
     , current_pkt_count_(0)
     , last_seq_(std::nullopt)
 {
-    // Pre-allocate buffer for maximum points (avoids reallocation)
-    point_buffer_.reserve(max_frame_points * 3);
+    // Pre-allocate both buffers for maximum points (avoids reallocation)
+    if (soa_) {
+        soa_buffer_.reserve(max_frame_points);
+        soa_spare_.reserve(max_frame_points);
+    } else {
+        point_buffer_.reserve(max_frame_points * 3);
+        spare_buffer_.reserve(max_frame_points * 3);
+    }
+
+    // Pre-size the voxel hash to avoid rehashing mid-frame
+    if (voxel_size_ > 0.0f) {
+        voxel_set_.reserve(max_frame_points);
+    }
+
+    // Pre-allocate the occupancy bitmask (cleared per frame, never resized)
+    if (occ_cell_size_ > 0.0f) {
+        occupancy_.assign(OCC_GRID_WORDS, 0);
+    }
+}
+
+// Quantize one coordinate onto the occupancy grid; far-field points clamp
+// to border cells instead of falling off the mask
+static inline int occ_axis(float v, float inv_cell) {
+    int c = static_cast<int>(std::floor(v * inv_cell)) + OCC_GRID_DIM / 2;
+    if (c < 0) c = 0;
+    if (c >= OCC_GRID_DIM) c = OCC_GRID_DIM - 1;
+    return c;
+}
+
+// Pack a quantized voxel coordinate into a 64-bit hash key (21 bits/axis,
+// biased so negative coordinates pack cleanly; ~±1000 km at 1mm leaves)
+static inline uint64_t voxel_key(float x, float y, float z, float inv_leaf) {
+    const int32_t bias = 1 << 20;
+    uint64_t ix = static_cast<uint64_t>(static_cast<int32_t>(std::floor(x * inv_leaf)) + bias) & 0x1FFFFF;
+    uint64_t iy = static_cast<uint64_t>(static_cast<int32_t>(std::floor(y * inv_leaf)) + bias) & 0x1FFFFF;
+    uint64_t iz = static_cast<uint64_t>(static_cast<int32_t>(std::floor(z * inv_leaf)) + bias) & 0x1FFFFF;
+    return (ix << 42) | (iy << 21) | iz;
+}
+
+std::optional<Frame> FrameBuilder::add_packet(
+    int64_t device_ts_ns,
+    const float* xyz_data,
+    size_t point_count,
+    uint32_t seq,
+    bool debug)
+{
+    return add_packet(device_ts_ns, xyz_data, nullptr, point_count, seq, debug);
 }
 
 std::optional<Frame> FrameBuilder::add_packet(
     int64_t device_ts_ns,
     const float* xyz_data,
+    const float* intensity_data,
     size_t point_count,
     uint32_t seq,
     bool debug)
@@ -127,13 +192,15 @@ std::optional<Frame> FrameBuilder::add_packet(
         }
 
         // Add packet to new frame
-        add_to_current_frame(device_ts_ns, xyz_data, point_count, seq, debug);
+        add_to_current_frame(device_ts_ns, xyz_data, intensity_data,
+                             point_count, seq, debug);
 
         return completed_frame;
     }
 
     // Add to current frame
-    add_to_current_frame(device_ts_ns, xyz_data, point_count, seq, debug);
+    add_to_current_frame(device_ts_ns, xyz_data, intensity_data,
+                         point_count, seq, debug);
 
     return std::nullopt;
 }
@@ -203,6 +270,20 @@ std::vector<Frame> FrameBuilder::add_packets_batch(
     return completed_frames;
 }
 
+void FrameBuilder::set_twist(float vx, float vy, float vz, float wz) {
+    twist_vx_ = vx;
+    twist_vy_ = vy;
+    twist_vz_ = vz;
+    twist_wz_ = wz;
+    deskew_ = true;
+}
+
+void FrameBuilder::clear_twist() {
+    deskew_ = false;
+    twist_vx_ = twist_vy_ = twist_vz_ = twist_wz_ = 0.0f;
+    packet_spans_.clear();
+}
+
 void FrameBuilder::reset() {
     current_point_count_ = 0;
     current_frame_start_ts_ = -1;
@@ -212,6 +293,9 @@ void FrameBuilder::reset() {
     current_pkt_count_ = 0;
     last_seq_ = std::nullopt;
     point_buffer_.clear();
+    soa_buffer_.clear();
+    voxel_set_.clear();
+    packet_spans_.clear();
 }
 
 // ============================================================================
@@ -226,17 +310,95 @@ void FrameBuilder::start_new_frame(int64_t device_ts_ns, uint32_t seq) {
     current_pkt_count_ = 0;
     current_point_count_ = 0;
     point_buffer_.clear();  // Clear previous data
+    soa_buffer_.clear();
+    voxel_set_.clear();     // Fresh voxel occupancy per frame
+    packet_spans_.clear();  // Fresh de-skew spans per frame
+
+    // Fresh spatial metadata (bounds seeded so the first point defines them)
+    for (int a = 0; a < 3; a++) {
+        aabb_min_[a] = std::numeric_limits<float>::max();
+        aabb_max_[a] = std::numeric_limits<float>::lowest();
+        centroid_sum_[a] = 0.0;
+    }
+    if (occ_cell_size_ > 0.0f) {
+        std::fill(occupancy_.begin(), occupancy_.end(), 0);
+    }
+}
+
+// Fold one point into the running AABB / centroid / occupancy grid
+// (SoA accumulation path; the AoS paths use the batch form below)
+void FrameBuilder::update_point_metadata(float x, float y, float z) {
+    aabb_min_[0] = std::min(aabb_min_[0], x);
+    aabb_min_[1] = std::min(aabb_min_[1], y);
+    aabb_min_[2] = std::min(aabb_min_[2], z);
+    aabb_max_[0] = std::max(aabb_max_[0], x);
+    aabb_max_[1] = std::max(aabb_max_[1], y);
+    aabb_max_[2] = std::max(aabb_max_[2], z);
+    centroid_sum_[0] += x;
+    centroid_sum_[1] += y;
+    centroid_sum_[2] += z;
+
+    if (occ_cell_size_ > 0.0f) {
+        int ix = occ_axis(x, inv_occ_cell_);
+        int iy = occ_axis(y, inv_occ_cell_);
+        int iz = occ_axis(z, inv_occ_cell_);
+        size_t bit = (static_cast<size_t>(ix) * OCC_GRID_DIM + iy)
+                     * OCC_GRID_DIM + iz;
+        occupancy_[bit >> 6] |= 1ULL << (bit & 63);
+    }
+}
+
+// Fold a contiguous run of xyz triplets into the running metadata. The
+// min/max/sum chains are kept in locals so the compiler can hold them in
+// vector registers; the occupancy pass is separate (scalar bit sets)
+void FrameBuilder::update_spatial_metadata(const float* xyz_data,
+                                           size_t point_count) {
+    float minx = aabb_min_[0], miny = aabb_min_[1], minz = aabb_min_[2];
+    float maxx = aabb_max_[0], maxy = aabb_max_[1], maxz = aabb_max_[2];
+    double sumx = 0.0, sumy = 0.0, sumz = 0.0;
+
+    for (size_t i = 0; i < point_count; i++) {
+        const float* pt = xyz_data + i * 3;
+        minx = std::min(minx, pt[0]);
+        miny = std::min(miny, pt[1]);
+        minz = std::min(minz, pt[2]);
+        maxx = std::max(maxx, pt[0]);
+        maxy = std::max(maxy, pt[1]);
+        maxz = std::max(maxz, pt[2]);
+        sumx += pt[0];
+        sumy += pt[1];
+        sumz += pt[2];
+    }
+
+    aabb_min_[0] = minx; aabb_min_[1] = miny; aabb_min_[2] = minz;
+    aabb_max_[0] = maxx; aabb_max_[1] = maxy; aabb_max_[2] = maxz;
+    centroid_sum_[0] += sumx;
+    centroid_sum_[1] += sumy;
+    centroid_sum_[2] += sumz;
+
+    if (occ_cell_size_ > 0.0f) {
+        for (size_t i = 0; i < point_count; i++) {
+            const float* pt = xyz_data + i * 3;
+            int ix = occ_axis(pt[0], inv_occ_cell_);
+            int iy = occ_axis(pt[1], inv_occ_cell_);
+            int iz = occ_axis(pt[2], inv_occ_cell_);
+            size_t bit = (static_cast<size_t>(ix) * OCC_GRID_DIM + iy)
+                         * OCC_GRID_DIM + iz;
+            occupancy_[bit >> 6] |= 1ULL << (bit & 63);
+        }
+    }
 }
 
 void FrameBuilder::add_to_current_frame(
     int64_t device_ts_ns,
     const float* xyz_data,
+    const float* intensity_data,
     size_t point_count,
     uint32_t seq,
     bool debug)
 {
     PROFILE_START();
-    g_add_to_frame_calls++;
+    stats_.add_to_frame_calls++;
 
     // Sequence tracking (detect gaps and reorders)
     if (last_seq_.has_value()) {
@@ -268,43 +430,97 @@ void FrameBuilder::add_to_current_frame(
         return;
     }
 
-    // Copy points directly into buffer (zero-copy accumulation)
-    const size_t offset = current_point_count_ * 3;
-    const size_t bytes = point_count * 3 * sizeof(float);
+    size_t points_accumulated = point_count;
+
+    if (soa_) {
+        // Structure-of-arrays accumulation: separate contiguous x/y/z and
+        // intensity channels (honours the voxel filter when enabled)
+        size_t kept = 0;
+        for (size_t i = 0; i < point_count; i++) {
+            const float* pt = xyz_data + i * 3;
+            if (voxel_size_ > 0.0f &&
+                !voxel_set_.insert(voxel_key(pt[0], pt[1], pt[2],
+                                             inv_voxel_size_)).second) {
+                continue;
+            }
+            soa_buffer_.x.push_back(pt[0]);
+            soa_buffer_.y.push_back(pt[1]);
+            soa_buffer_.z.push_back(pt[2]);
+            soa_buffer_.intensity.push_back(
+                intensity_data != nullptr ? intensity_data[i] : 0.0f);
+            update_point_metadata(pt[0], pt[1], pt[2]);
+            kept++;
+        }
+        stats_.voxel_dropped += point_count - kept;
+        points_accumulated = kept;
+    } else if (voxel_size_ > 0.0f) {
+        // Incremental voxel-grid downsample: keep the first point landing in
+        // each voxel, tracked in a spatial hash cleared at frame start
+        const size_t offset = current_point_count_ * 3;
+        size_t kept = 0;
+        for (size_t i = 0; i < point_count; i++) {
+            const float* pt = xyz_data + i * 3;
+            if (voxel_set_.insert(voxel_key(pt[0], pt[1], pt[2], inv_voxel_size_)).second) {
+                point_buffer_.push_back(pt[0]);
+                point_buffer_.push_back(pt[1]);
+                point_buffer_.push_back(pt[2]);
+                kept++;
+            }
+        }
+        if (kept > 0) {
+            // Kept points are contiguous at the old fill level
+            update_spatial_metadata(&point_buffer_[offset], kept);
+        }
+        stats_.voxel_dropped += point_count - kept;
+        points_accumulated = kept;
+    } else {
+        // Copy points directly into buffer (zero-copy accumulation)
+        const size_t offset = current_point_count_ * 3;
+        const size_t bytes = point_count * 3 * sizeof(float);
+
+        // Ensure buffer has enough space
+        if (point_buffer_.size() < offset + point_count * 3) {
+            point_buffer_.resize(offset + point_count * 3);
+        }
 
-    // Ensure buffer has enough space
-    if (point_buffer_.size() < offset + point_count * 3) {
-        point_buffer_.resize(offset + point_count * 3);
-    }
+        // Profile memcpy
+        {
+            auto memcpy_start = std::chrono::high_resolution_clock::now();
+            std::memcpy(&point_buffer_[offset], xyz_data, bytes);
+            auto memcpy_end = std::chrono::high_resolution_clock::now();
+            g_memcpy_hist->record_ns(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    memcpy_end - memcpy_start).count());
+
+            stats_.memcpy_calls++;
+            stats_.memcpy_bytes += bytes;
+        }
 
-    // Profile memcpy
-    {
-        auto memcpy_start = std::chrono::high_resolution_clock::now();
-        std::memcpy(&point_buffer_[offset], xyz_data, bytes);
-        auto memcpy_end = std::chrono::high_resolution_clock::now();
-        auto memcpy_us = std::chrono::duration_cast<std::chrono::microseconds>(memcpy_end - memcpy_start).count();
+        update_spatial_metadata(xyz_data, point_count);
+    }
 
-        g_memcpy_calls++;
-        g_memcpy_bytes += bytes;
-        g_memcpy_total_us += memcpy_us;
+    // De-skew span: this packet's kept run starts at the old fill level
+    // and was captured at device_ts_ns
+    if (deskew_ && points_accumulated > 0) {
+        packet_spans_.push_back({current_point_count_, device_ts_ns});
     }
 
     // Update metadata
-    current_point_count_ += point_count;
+    current_point_count_ += points_accumulated;
     current_frame_end_ts_ = device_ts_ns;
     current_seq_last_ = seq;
     current_pkt_count_++;
 
     // Update statistics
     stats_.packets_added++;
-    stats_.points_added += point_count;
+    stats_.points_added += points_accumulated;
 
-    PROFILE_END("add_to_frame", g_add_to_frame_total_us);
+    PROFILE_END(g_add_packet_hist);
 }
 
 std::optional<Frame> FrameBuilder::close_current_frame(bool debug) {
     PROFILE_START();
-    g_close_frame_calls++;
+    stats_.close_frame_calls++;
 
     if (current_point_count_ == 0) {
         if (debug) {
@@ -321,21 +537,46 @@ std::optional<Frame> FrameBuilder::close_current_frame(bool debug) {
     frame.seq_first = current_seq_first_;
     frame.seq_last = current_seq_last_;
     frame.pkt_count = current_pkt_count_;
+    frame.sensor_id = sensor_id_;
+
+    // Spatial metadata (maintained point-by-point during accumulation)
+    for (int a = 0; a < 3; a++) {
+        frame.aabb_min[a] = aabb_min_[a];
+        frame.aabb_max[a] = aabb_max_[a];
+        frame.centroid[a] = static_cast<float>(
+            centroid_sum_[a] / static_cast<double>(current_point_count_));
+    }
+    if (occ_cell_size_ > 0.0f) {
+        frame.occ_cell_size = occ_cell_size_;
+        frame.occupancy = std::move(occupancy_);
+        occupancy_.assign(OCC_GRID_WORDS, 0);
+    }
 
-    // Copy accumulated points (single copy at frame close)
-    frame.xyz_data.resize(current_point_count_ * 3);
-
-    // Profile frame close memcpy
-    {
-        auto memcpy_start = std::chrono::high_resolution_clock::now();
-        const size_t bytes = current_point_count_ * 3 * sizeof(float);
-        std::memcpy(frame.xyz_data.data(), point_buffer_.data(), bytes);
-        auto memcpy_end = std::chrono::high_resolution_clock::now();
-        auto memcpy_us = std::chrono::duration_cast<std::chrono::microseconds>(memcpy_end - memcpy_start).count();
+    // Double-buffer handoff: move the full buffer into the outgoing frame
+    // (O(1) -- no end-of-frame memcpy) and continue accumulation into the
+    // spare buffer. A fresh spare is reserved for the next close.
+    if (soa_) {
+        frame.soa = true;
+        frame.x_data = std::move(soa_buffer_.x);
+        frame.y_data = std::move(soa_buffer_.y);
+        frame.z_data = std::move(soa_buffer_.z);
+        frame.intensity_data = std::move(soa_buffer_.intensity);
+        soa_buffer_ = std::move(soa_spare_);
+        soa_buffer_.clear();
+        soa_spare_ = SoABuffers();
+        soa_spare_.reserve(max_frame_points_);
+    } else {
+        frame.xyz_data = std::move(point_buffer_);
+        point_buffer_ = std::move(spare_buffer_);
+        point_buffer_.clear();
+        spare_buffer_ = std::vector<float>();
+        spare_buffer_.reserve(max_frame_points_ * 3);
+    }
 
-        g_memcpy_calls++;
-        g_memcpy_bytes += bytes;
-        g_memcpy_total_us += memcpy_us;
+    // Motion compensation: re-project the closed frame to its end time
+    if (deskew_ && !packet_spans_.empty()) {
+        deskew_frame(frame);
+        packet_spans_.clear();
     }
 
     // Update statistics
@@ -349,10 +590,73 @@ std::optional<Frame> FrameBuilder::close_current_frame(bool debug) {
     current_point_count_ = 0;
     current_frame_start_ts_ = -1;
 
-    PROFILE_END("close_frame", g_close_frame_total_us);
+    PROFILE_END(g_frame_close_hist);
     return frame;
 }
 
+// Linearly re-project every point to the frame-end timestamp. A point
+// captured dt seconds before frame end, seen from the end pose, sits at
+// Rz(-wz*dt) * (p - v*dt): the platform translated v*dt and yawed wz*dt
+// after observing it. First-order (constant twist over the window), which
+// at 100 ms frames is the regime where linear de-skew is valid anyway.
+// One cos/sin and one translation per packet span; the inner loops over
+// contiguous points are plain mul/add chains the compiler can vectorize.
+// The frame's spatial metadata is left as accumulated: the correction
+// shifts points by at most |v| * frame_period (~centimeters), within the
+// tolerance of the coarse AABB / occupancy consumers.
+void FrameBuilder::deskew_frame(Frame& frame) {
+    const int64_t end_ts = frame.end_ts_ns;
+    uint64_t reprojected = 0;
+
+    for (size_t s = 0; s < packet_spans_.size(); s++) {
+        const size_t begin = packet_spans_[s].begin;
+        const size_t end = (s + 1 < packet_spans_.size())
+                               ? packet_spans_[s + 1].begin
+                               : frame.point_count;
+        if (end <= begin) {
+            continue;
+        }
+
+        const float dt = static_cast<float>(end_ts - packet_spans_[s].ts_ns) * 1e-9f;
+        if (dt <= 0.0f) {
+            continue;  // The closing packet itself needs no correction
+        }
+
+        const float tx = twist_vx_ * dt;
+        const float ty = twist_vy_ * dt;
+        const float tz = twist_vz_ * dt;
+        const float c = std::cos(-twist_wz_ * dt);
+        const float sn = std::sin(-twist_wz_ * dt);
+
+        if (frame.soa) {
+            float* xs = frame.x_data.data();
+            float* ys = frame.y_data.data();
+            float* zs = frame.z_data.data();
+            for (size_t i = begin; i < end; i++) {
+                const float px = xs[i] - tx;
+                const float py = ys[i] - ty;
+                xs[i] = c * px - sn * py;
+                ys[i] = sn * px + c * py;
+                zs[i] -= tz;
+            }
+        } else {
+            float* xyz = frame.xyz_data.data();
+            for (size_t i = begin; i < end; i++) {
+                float* pt = xyz + i * 3;
+                const float px = pt[0] - tx;
+                const float py = pt[1] - ty;
+                pt[0] = c * px - sn * py;
+                pt[1] = sn * px + c * py;
+                pt[2] -= tz;
+            }
+        }
+
+        reprojected += end - begin;
+    }
+
+    stats_.deskewed_points += reprojected;
+}
+
 // Sequence tracking helpers
 bool FrameBuilder::is_sequence_gap(uint32_t current_seq, uint32_t last_seq) const {
     // Allow wrap-around (uint32_t overflow)
@@ -365,41 +669,162 @@ bool FrameBuilder::is_sequence_reorder(uint32_t current_seq, uint32_t last_seq)
     return current_seq < last_seq && (last_seq - current_seq < 1000); // Not wrap-around
 }
 
+// ============================================================================
+// MultiSensorFrameBuilder implementation
+// ============================================================================
+
+MultiSensorFrameBuilder::MultiSensorFrameBuilder(double frame_period_s,
+                                                 size_t max_frame_points,
+                                                 double voxel_size,
+                                                 bool soa,
+                                                 double occupancy_cell_size)
+    : frame_period_s_(frame_period_s)
+    , max_frame_points_(max_frame_points)
+    , voxel_size_(voxel_size)
+    , soa_(soa)
+    , occupancy_cell_size_(occupancy_cell_size)
+{
+}
+
+MultiSensorFrameBuilder::SensorState& MultiSensorFrameBuilder::get_or_create(uint16_t sensor_id) {
+    auto it = sensors_.find(sensor_id);
+    if (it == sensors_.end()) {
+        it = sensors_.emplace(
+            sensor_id,
+            std::unique_ptr<SensorState>(
+                new SensorState(frame_period_s_, max_frame_points_, sensor_id,
+                                voxel_size_, soa_, occupancy_cell_size_))
+        ).first;
+        if (deskew_) {
+            it->second->builder.set_twist(twist_vx_, twist_vy_, twist_vz_,
+                                          twist_wz_);
+        }
+    }
+    return *it->second;
+}
+
+void MultiSensorFrameBuilder::set_twist(float vx, float vy, float vz,
+                                        float wz) {
+    deskew_ = true;
+    twist_vx_ = vx;
+    twist_vy_ = vy;
+    twist_vz_ = vz;
+    twist_wz_ = wz;
+    for (auto& entry : sensors_) {
+        entry.second->builder.set_twist(vx, vy, vz, wz);
+    }
+}
+
+void MultiSensorFrameBuilder::clear_twist() {
+    deskew_ = false;
+    twist_vx_ = twist_vy_ = twist_vz_ = twist_wz_ = 0.0f;
+    for (auto& entry : sensors_) {
+        entry.second->builder.clear_twist();
+    }
+}
+
+std::optional<Frame> MultiSensorFrameBuilder::add_packet(
+    uint16_t sensor_id,
+    int64_t device_ts_ns,
+    const float* xyz_data,
+    size_t point_count,
+    uint32_t seq,
+    bool debug)
+{
+    SensorState& state = get_or_create(sensor_id);
+
+    if (debug && state.stats.packets_added == 0) {
+        std::cerr << "[DEMUX] New sensor: id=" << sensor_id << std::endl;
+    }
+
+    return state.builder.add_packet(device_ts_ns, xyz_data, point_count, seq, debug);
+}
+
+std::optional<Frame> MultiSensorFrameBuilder::add_packet(
+    uint16_t sensor_id,
+    int64_t device_ts_ns,
+    const float* xyz_data,
+    const float* intensity_data,
+    size_t point_count,
+    uint32_t seq,
+    bool debug)
+{
+    SensorState& state = get_or_create(sensor_id);
+
+    if (debug && state.stats.packets_added == 0) {
+        std::cerr << "[DEMUX] New sensor: id=" << sensor_id << std::endl;
+    }
+
+    return state.builder.add_packet(device_ts_ns, xyz_data, intensity_data,
+                                    point_count, seq, debug);
+}
+
+std::vector<Frame> MultiSensorFrameBuilder::flush(bool debug) {
+    std::vector<Frame> frames;
+    frames.reserve(sensors_.size());
+
+    for (auto& entry : sensors_) {
+        auto frame = entry.second->builder.flush(debug);
+        if (frame.has_value()) {
+            frames.push_back(std::move(*frame));
+        }
+    }
+
+    return frames;
+}
+
+void MultiSensorFrameBuilder::reset() {
+    for (auto& entry : sensors_) {
+        entry.second->builder.reset();
+        entry.second->stats.reset();
+    }
+}
+
+std::vector<uint16_t> MultiSensorFrameBuilder::sensor_ids() const {
+    std::vector<uint16_t> ids;
+    ids.reserve(sensors_.size());
+    for (const auto& entry : sensors_) {
+        ids.push_back(entry.first);
+    }
+    return ids;
+}
+
+const FrameBuilderStats* MultiSensorFrameBuilder::stats_for(uint16_t sensor_id) const {
+    auto it = sensors_.find(sensor_id);
+    if (it == sensors_.end()) {
+        return nullptr;
+    }
+    return &it->second->stats;
+}
+
 // ============================================================================
 // Profiling statistics export
 // ============================================================================
 
-void print_profiling_stats() {
+void print_profiling_stats(const FrameBuilderStats& stats) {
     std::cerr << "\n========================================\n";
     std::cerr << "Frame Builder C++ Profiling Statistics\n";
     std::cerr << "========================================\n";
 
     std::cerr << "Function Calls:\n";
-    std::cerr << "  add_to_frame: " << g_add_to_frame_calls << " calls\n";
-    std::cerr << "  close_frame: " << g_close_frame_calls << " calls\n";
-
-    if (g_add_to_frame_calls > 0) {
-        double avg_add = static_cast<double>(g_add_to_frame_total_us) / g_add_to_frame_calls;
-        std::cerr << "  avg add_to_frame: " << avg_add << " μs/call\n";
-    }
-
-    if (g_close_frame_calls > 0) {
-        double avg_close = static_cast<double>(g_close_frame_total_us) / g_close_frame_calls;
-        std::cerr << "  avg close_frame: " << avg_close << " μs/call\n";
-    }
+    std::cerr << "  add_to_frame: " << stats.add_to_frame_calls << " calls\n";
+    std::cerr << "  close_frame: " << stats.close_frame_calls << " calls\n";
 
     std::cerr << "\nmemcpy Statistics:\n";
-    std::cerr << "  Total calls: " << g_memcpy_calls << "\n";
-    std::cerr << "  Total bytes: " << g_memcpy_bytes << " ("
-              << (g_memcpy_bytes / 1024.0 / 1024.0) << " MB)\n";
-    std::cerr << "  Total time: " << g_memcpy_total_us << " μs\n";
+    std::cerr << "  Total calls: " << stats.memcpy_calls << "\n";
+    std::cerr << "  Total bytes: " << stats.memcpy_bytes << " ("
+              << (stats.memcpy_bytes / 1024.0 / 1024.0) << " MB)\n";
 
-    if (g_memcpy_calls > 0) {
-        double avg_bytes = static_cast<double>(g_memcpy_bytes) / g_memcpy_calls;
-        double avg_us = static_cast<double>(g_memcpy_total_us) / g_memcpy_calls;
-        std::cerr << "  avg per call: " << avg_bytes << " bytes, " << avg_us << " μs\n";
+    if (stats.memcpy_calls > 0) {
+        double avg_bytes = static_cast<double>(stats.memcpy_bytes) / stats.memcpy_calls;
+        std::cerr << "  avg per call: " << avg_bytes << " bytes\n";
     }
 
+    // Per-stage latency percentiles (all registered stages, including the
+    // rx loop's parse stage when running under lidar_rx_cpp)
+    std::cerr << "\nStage Latencies:\n";
+    latency::HistogramRegistry::instance().dump(STDERR_FILENO);
+
     std::cerr << "========================================\n\n";
 }
 
@@ -22,7 +22,61 @@ static std::atomic<size_t> g_pybind_dict_creates{0};
 // Helper: Convert Frame to Python dict (matching Python API)
 // ============================================================================
 
-py::object frame_to_dict(const Frame& frame) {
+// Move one SoA channel into a capsule-owned 1-D NumPy array (zero-copy)
+static py::array_t<float> channel_array(std::vector<float>&& channel) {
+    auto* owner = new std::vector<float>(std::move(channel));
+
+    py::capsule cap(owner, [](void* p) {
+        delete static_cast<std::vector<float>*>(p);
+    });
+
+    return py::array_t<float>({static_cast<py::ssize_t>(owner->size())},
+                              {sizeof(float)}, owner->data(), cap);
+}
+
+// Spatial metadata keys shared by the AoS and SoA dict layouts; the
+// occupancy bitmask moves across as a zero-copy uint64 array
+static void spatial_to_dict(Frame& frame, py::dict& result) {
+    result["aabb_min"] = py::make_tuple(frame.aabb_min[0], frame.aabb_min[1],
+                                        frame.aabb_min[2]);
+    result["aabb_max"] = py::make_tuple(frame.aabb_max[0], frame.aabb_max[1],
+                                        frame.aabb_max[2]);
+    result["centroid"] = py::make_tuple(frame.centroid[0], frame.centroid[1],
+                                        frame.centroid[2]);
+
+    if (!frame.occupancy.empty()) {
+        result["occ_cell_size"] = frame.occ_cell_size;
+        result["occ_grid_dim"] = OCC_GRID_DIM;
+
+        auto* owner = new std::vector<uint64_t>(std::move(frame.occupancy));
+        py::capsule cap(owner, [](void* p) {
+            delete static_cast<std::vector<uint64_t>*>(p);
+        });
+        result["occupancy"] = py::array_t<uint64_t>(
+            {static_cast<py::ssize_t>(owner->size())},
+            {sizeof(uint64_t)}, owner->data(), cap);
+    }
+}
+
+py::object frame_to_dict(Frame& frame) {
+    // SoA frames: individual zero-copy channel arrays, no interleave
+    if (frame.soa) {
+        py::dict result;
+        result["x"] = channel_array(std::move(frame.x_data));
+        result["y"] = channel_array(std::move(frame.y_data));
+        result["z"] = channel_array(std::move(frame.z_data));
+        result["intensity"] = channel_array(std::move(frame.intensity_data));
+        result["start_ts_ns"] = frame.start_ts_ns;
+        result["end_ts_ns"] = frame.end_ts_ns;
+        result["seq_first"] = frame.seq_first;
+        result["seq_last"] = frame.seq_last;
+        result["pkt_count"] = frame.pkt_count;
+        result["point_count"] = frame.point_count;
+        result["sensor_id"] = frame.sensor_id;
+        spatial_to_dict(frame, result);
+        return result;
+    }
+
     py::dict result;
 
     // Create NumPy array for xyz with capsule-based ownership
@@ -51,6 +105,8 @@ py::object frame_to_dict(const Frame& frame) {
     result["seq_last"] = frame.seq_last;
     result["pkt_count"] = frame.pkt_count;
     result["point_count"] = frame.point_count;
+    result["sensor_id"] = frame.sensor_id;
+    spatial_to_dict(frame, result);
 
     return result;
 }
@@ -63,10 +119,14 @@ class FrameBuilderPy {
 public:
     explicit FrameBuilderPy(double frame_period_s,
                             size_t max_frame_points,
-                            py::object stats_obj)
+                            py::object stats_obj,
+                            double voxel_size = 0.0,
+                            bool soa = false,
+                            double occupancy_cell_size = 0.0)
         : stats_(),
           external_stats_(stats_obj),
-          builder_(frame_period_s, max_frame_points, stats_)
+          builder_(frame_period_s, max_frame_points, stats_, voxel_size, soa,
+                   occupancy_cell_size)
     {
         // Initialize external stats if provided
         if (!external_stats_.is_none()) {
@@ -74,10 +134,11 @@ public:
         }
     }
 
-    // Add packet (accepts NumPy array)
+    // Add packet (accepts NumPy array; intensity only retained in SoA mode)
     py::object add_packet(int64_t device_ts_ns,
                           py::array_t<float> points_xyz,
                           uint32_t seq,
+                          py::object intensity = py::none(),
                           bool debug = false)
     {
         g_pybind_calls++;
@@ -92,10 +153,23 @@ public:
         // Get direct pointer to data (zero-copy)
         const float* xyz_data = points_xyz.data();
         size_t point_count = points_xyz.shape(0);
+
+        // Optional intensity channel (contiguous N floats)
+        py::array_t<float> intensity_arr;
+        const float* intensity_data = nullptr;
+        if (!intensity.is_none()) {
+            intensity_arr = intensity.cast<py::array_t<float>>();
+            if (intensity_arr.ndim() != 1 ||
+                static_cast<size_t>(intensity_arr.shape(0)) != point_count) {
+                throw std::runtime_error("intensity must be (N,) array matching points_xyz");
+            }
+            intensity_data = intensity_arr.data();
+        }
         auto t2 = std::chrono::high_resolution_clock::now();
 
         // Call C++ method
-        auto result = builder_.add_packet(device_ts_ns, xyz_data, point_count, seq, debug);
+        auto result = builder_.add_packet(device_ts_ns, xyz_data, intensity_data,
+                                          point_count, seq, debug);
         auto t3 = std::chrono::high_resolution_clock::now();
 
         // Sync stats only when frame is closed (major performance optimization)
@@ -192,7 +266,7 @@ public:
 
         // Convert frames to Python dicts
         py::list result;
-        for (const auto& frame : frames) {
+        for (auto& frame : frames) {
             result.append(frame_to_dict(frame));
         }
 
@@ -229,6 +303,12 @@ public:
         }
     }
 
+    // Motion compensation twist (see FrameBuilder::set_twist)
+    void set_twist(float vx, float vy, float vz, float wz) {
+        builder_.set_twist(vx, vy, vz, wz);
+    }
+    void clear_twist() { builder_.clear_twist(); }
+
     // Get statistics
     const FrameBuilderStats& stats() const {
         return builder_.stats();
@@ -249,7 +329,113 @@ private:
         external_stats_.attr("seq_gaps") = s.seq_gaps;
         external_stats_.attr("seq_reorders") = s.seq_reorders;
         external_stats_.attr("overflow_frames") = s.overflow_frames;
+        external_stats_.attr("voxel_dropped") = s.voxel_dropped;
+        external_stats_.attr("deskewed_points") = s.deskewed_points;
+        external_stats_.attr("add_to_frame_calls") = s.add_to_frame_calls;
+        external_stats_.attr("close_frame_calls") = s.close_frame_calls;
+        external_stats_.attr("memcpy_calls") = s.memcpy_calls;
+        external_stats_.attr("memcpy_bytes") = s.memcpy_bytes;
+    }
+};
+
+// ============================================================================
+// Python-compatible wrapper for MultiSensorFrameBuilder
+// ============================================================================
+
+class MultiSensorFrameBuilderPy {
+public:
+    MultiSensorFrameBuilderPy(double frame_period_s, size_t max_frame_points,
+                              double voxel_size = 0.0, bool soa = false,
+                              double occupancy_cell_size = 0.0)
+        : builder_(frame_period_s, max_frame_points, voxel_size, soa,
+                   occupancy_cell_size) {}
+
+    // Add packet for a specific sensor (accepts NumPy array)
+    py::object add_packet(uint16_t sensor_id,
+                          int64_t device_ts_ns,
+                          py::array_t<float> points_xyz,
+                          uint32_t seq,
+                          py::object intensity = py::none(),
+                          bool debug = false)
+    {
+        if (points_xyz.ndim() != 2 || points_xyz.shape(1) != 3) {
+            throw std::runtime_error("points_xyz must be (N, 3) array");
+        }
+        size_t point_count = points_xyz.shape(0);
+
+        py::array_t<float> intensity_arr;
+        const float* intensity_data = nullptr;
+        if (!intensity.is_none()) {
+            intensity_arr = intensity.cast<py::array_t<float>>();
+            if (intensity_arr.ndim() != 1 ||
+                static_cast<size_t>(intensity_arr.shape(0)) != point_count) {
+                throw std::runtime_error("intensity must be (N,) array matching points_xyz");
+            }
+            intensity_data = intensity_arr.data();
+        }
+
+        auto result = builder_.add_packet(sensor_id, device_ts_ns,
+                                          points_xyz.data(), intensity_data,
+                                          point_count, seq, debug);
+
+        if (!result.has_value()) {
+            return py::none();
+        }
+        return frame_to_dict(*result);
     }
+
+    // Flush all sensors' remaining frames
+    py::list flush(bool debug = false) {
+        py::list result;
+        auto frames = builder_.flush(debug);
+        for (auto& frame : frames) {
+            result.append(frame_to_dict(frame));
+        }
+        return result;
+    }
+
+    void reset() { builder_.reset(); }
+
+    void set_twist(float vx, float vy, float vz, float wz) {
+        builder_.set_twist(vx, vy, vz, wz);
+    }
+    void clear_twist() { builder_.clear_twist(); }
+
+    py::list sensor_ids() const {
+        py::list result;
+        for (uint16_t id : builder_.sensor_ids()) {
+            result.append(id);
+        }
+        return result;
+    }
+
+    // Per-sensor statistics: {sensor_id: {counter: value, ...}}
+    py::dict stats() const {
+        py::dict result;
+        for (uint16_t id : builder_.sensor_ids()) {
+            const FrameBuilderStats* s = builder_.stats_for(id);
+            if (s == nullptr) {
+                continue;
+            }
+            py::dict counters;
+            counters["frames_built"] = s->frames_built;
+            counters["packets_added"] = s->packets_added;
+            counters["points_added"] = s->points_added;
+            counters["late_packets"] = s->late_packets;
+            counters["seq_gaps"] = s->seq_gaps;
+            counters["seq_reorders"] = s->seq_reorders;
+            counters["overflow_frames"] = s->overflow_frames;
+            counters["voxel_dropped"] = s->voxel_dropped;
+            counters["deskewed_points"] = s->deskewed_points;
+            counters["memcpy_calls"] = s->memcpy_calls;
+            counters["memcpy_bytes"] = s->memcpy_bytes;
+            result[py::int_(id)] = counters;
+        }
+        return result;
+    }
+
+private:
+    MultiSensorFrameBuilder builder_;
 };
 
 // ============================================================================
@@ -305,41 +491,64 @@ PYBIND11_MODULE(frame_builder_cpp, m) {
         .def_readwrite("seq_gaps", &FrameBuilderStats::seq_gaps)
         .def_readwrite("seq_reorders", &FrameBuilderStats::seq_reorders)
         .def_readwrite("overflow_frames", &FrameBuilderStats::overflow_frames)
+        .def_readwrite("voxel_dropped", &FrameBuilderStats::voxel_dropped)
+        .def_readwrite("deskewed_points", &FrameBuilderStats::deskewed_points)
+        .def_readwrite("add_to_frame_calls", &FrameBuilderStats::add_to_frame_calls)
+        .def_readwrite("close_frame_calls", &FrameBuilderStats::close_frame_calls)
+        .def_readwrite("memcpy_calls", &FrameBuilderStats::memcpy_calls)
+        .def_readwrite("memcpy_bytes", &FrameBuilderStats::memcpy_bytes)
         .def("reset", &FrameBuilderStats::reset)
         .def("__repr__", &FrameBuilderStats::repr);
 
     // FrameBuilder class (Python-compatible wrapper)
     py::class_<FrameBuilderPy>(m, "FrameBuilder")
-        .def(py::init<double, size_t, py::object>(),
+        .def(py::init<double, size_t, py::object, double, bool, double>(),
              py::arg("frame_period_s"),
              py::arg("max_frame_points") = 120000,
              py::arg("stats") = py::none(),
+             py::arg("voxel_size") = 0.0,
+             py::arg("soa") = false,
+             py::arg("occupancy_cell_size") = 0.0,
              "Initialize Frame Builder\n\n"
              "Args:\n"
              "    frame_period_s (float): Frame duration in seconds\n"
              "    max_frame_points (int): Maximum points per frame (default: 120000)\n"
-             "    stats (FrameBuilderStats): Optional external stats object")
+             "    stats (FrameBuilderStats): Optional external stats object\n"
+             "    voxel_size (float): Voxel leaf size in meters; > 0 enables\n"
+             "        incremental downsampling (first point per voxel kept)\n"
+             "    soa (bool): Accumulate separate contiguous x/y/z/intensity\n"
+             "        channels instead of interleaved xyz; completed frames\n"
+             "        carry 'x'/'y'/'z'/'intensity' zero-copy arrays\n"
+             "    occupancy_cell_size (float): Cell edge length in meters;\n"
+             "        > 0 adds a coarse occupancy bitmask per frame\n"
+             "        ('occupancy', 32^3 bits, x-major, origin-centered)")
         .def("add_packet", &FrameBuilderPy::add_packet,
              py::arg("device_ts_ns"),
              py::arg("points_xyz"),
              py::arg("seq"),
+             py::arg("intensity") = py::none(),
              py::arg("debug") = false,
              "Add packet to current frame\n\n"
              "Args:\n"
              "    device_ts_ns (int): Device timestamp in nanoseconds\n"
              "    points_xyz (np.ndarray): Point cloud (N, 3) float32\n"
              "    seq (int): Sequence number\n"
+             "    intensity (np.ndarray): Optional (N,) float32 reflectivity\n"
+             "        channel (retained in SoA mode, zero-filled if omitted)\n"
              "    debug (bool): Enable debug logging\n\n"
              "Returns:\n"
              "    dict or None: Completed frame or None\n"
              "        {\n"
-             "            'xyz': np.ndarray (N, 3),\n"
+             "            'xyz': np.ndarray (N, 3),  # AoS mode\n"
+             "            'x'/'y'/'z'/'intensity': np.ndarray (N,),  # SoA mode\n"
              "            'start_ts_ns': int,\n"
              "            'end_ts_ns': int,\n"
              "            'seq_first': int,\n"
              "            'seq_last': int,\n"
              "            'pkt_count': int,\n"
-             "            'point_count': int\n"
+             "            'point_count': int,\n"
+             "            'aabb_min'/'aabb_max'/'centroid': (x, y, z),\n"
+             "            'occupancy': np.ndarray (uint64), optional\n"
              "        }")
         .def("add_packets_batch", &FrameBuilderPy::add_packets_batch,
              py::arg("device_ts_ns_batch"),
@@ -371,12 +580,84 @@ PYBIND11_MODULE(frame_builder_cpp, m) {
              "    dict or None: Remaining frame or None")
         .def("reset", &FrameBuilderPy::reset,
              "Reset frame builder state")
+        .def("set_twist", &FrameBuilderPy::set_twist,
+             py::arg("vx"), py::arg("vy"), py::arg("vz"), py::arg("wz"),
+             "Set the motion-compensation twist (sensor frame)\n\n"
+             "While set, completed frames are de-skewed: every point is\n"
+             "linearly re-projected to the frame-end timestamp using its\n"
+             "packet's capture time. Call per frame as the velocity\n"
+             "estimate updates.\n\n"
+             "Args:\n"
+             "    vx, vy, vz (float): Linear velocity in m/s\n"
+             "    wz (float): Yaw rate in rad/s")
+        .def("clear_twist", &FrameBuilderPy::clear_twist,
+             "Disable motion compensation")
         .def_property_readonly("stats", &FrameBuilderPy::stats,
                                "Get frame builder statistics");
 
+    // MultiSensorFrameBuilder class (per-sensor demultiplexing)
+    py::class_<MultiSensorFrameBuilderPy>(m, "MultiSensorFrameBuilder")
+        .def(py::init<double, size_t, double, bool, double>(),
+             py::arg("frame_period_s"),
+             py::arg("max_frame_points") = 120000,
+             py::arg("voxel_size") = 0.0,
+             py::arg("soa") = false,
+             py::arg("occupancy_cell_size") = 0.0,
+             "Initialize multi-sensor frame builder\n\n"
+             "Maintains an independent frame window, buffer, and sequence\n"
+             "tracking per sensor_id so multi-LiDAR rigs can share one\n"
+             "receiver instance.\n\n"
+             "Args:\n"
+             "    frame_period_s (float): Frame duration in seconds\n"
+             "    max_frame_points (int): Maximum points per frame, per sensor\n"
+             "    voxel_size (float): Voxel leaf size in meters; > 0 enables\n"
+             "        incremental downsampling per sensor\n"
+             "    soa (bool): Per-channel accumulation (see FrameBuilder)\n"
+             "    occupancy_cell_size (float): > 0 adds a coarse occupancy\n"
+             "        bitmask per frame (see FrameBuilder)")
+        .def("add_packet", &MultiSensorFrameBuilderPy::add_packet,
+             py::arg("sensor_id"),
+             py::arg("device_ts_ns"),
+             py::arg("points_xyz"),
+             py::arg("seq"),
+             py::arg("intensity") = py::none(),
+             py::arg("debug") = false,
+             "Add packet for a specific sensor\n\n"
+             "Args:\n"
+             "    sensor_id (int): Source sensor (PacketHeader.sensor_id)\n"
+             "    device_ts_ns (int): Device timestamp in nanoseconds\n"
+             "    points_xyz (np.ndarray): Point cloud (N, 3) float32\n"
+             "    seq (int): Sequence number\n"
+             "    debug (bool): Enable debug logging\n\n"
+             "Returns:\n"
+             "    dict or None: That sensor's completed frame (includes\n"
+             "        'sensor_id') or None")
+        .def("flush", &MultiSensorFrameBuilderPy::flush,
+             py::arg("debug") = false,
+             "Flush all sensors' remaining frames\n\n"
+             "Returns:\n"
+             "    list[dict]: One frame per sensor with pending points")
+        .def("reset", &MultiSensorFrameBuilderPy::reset,
+             "Reset all per-sensor state")
+        .def("set_twist", &MultiSensorFrameBuilderPy::set_twist,
+             py::arg("vx"), py::arg("vy"), py::arg("vz"), py::arg("wz"),
+             "Set the motion-compensation twist for every sensor's builder\n"
+             "(see FrameBuilder.set_twist)")
+        .def("clear_twist", &MultiSensorFrameBuilderPy::clear_twist,
+             "Disable motion compensation for every sensor's builder")
+        .def("sensor_ids", &MultiSensorFrameBuilderPy::sensor_ids,
+             "List of sensor IDs seen so far")
+        .def("stats", &MultiSensorFrameBuilderPy::stats,
+             "Per-sensor statistics\n\n"
+             "Returns:\n"
+             "    dict: {sensor_id: {counter: value, ...}}");
+
     // Profiling functions
     m.def("print_cpp_profiling_stats", &frame_builder::print_profiling_stats,
-          "Print C++ internal profiling statistics");
+          py::arg("stats"),
+          "Print C++ internal profiling statistics for one builder's\n"
+          "FrameBuilderStats (counters are per-instance; the stage latency\n"
+          "histograms are process-wide)");
     m.def("print_pybind_profiling_stats", &print_pybind_profiling_stats,
           "Print pybind11 boundary profiling statistics");
 }
@@ -0,0 +1,334 @@
+#include "frame_log_cpp.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace frame_log {
+
+// ============================================================================
+// FrameLogWriter Implementation
+// ============================================================================
+
+FrameLogWriter::FrameLogWriter(const std::string& path)
+    : path_(path) {}
+
+FrameLogWriter::~FrameLogWriter() {
+    close();
+}
+
+bool FrameLogWriter::open() {
+    if (fd_ >= 0) {
+        return true;  // Already open
+    }
+
+    fd_ = ::open(path_.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);
+    if (fd_ < 0) {
+        std::cerr << "[LOG] Failed to create " << path_ << ": "
+                  << strerror(errno) << std::endl;
+        return false;
+    }
+
+    capacity_ = 0;
+    write_offset_ = 0;
+    index_.clear();
+
+    if (!ensure_capacity(sizeof(LogFileHeader))) {
+        close();
+        return false;
+    }
+
+    LogFileHeader header;
+    header.magic = LOG_MAGIC;
+    header.version = LOG_VERSION;
+    header.reserved = 0;
+    std::memcpy(map_, &header, sizeof(header));
+    write_offset_ = sizeof(header);
+
+    return true;
+}
+
+bool FrameLogWriter::ensure_capacity(size_t record_size) {
+    if (write_offset_ + record_size <= capacity_) {
+        return true;
+    }
+
+    // Grow by whole chunks: one ftruncate + remap per LOG_CHUNK_BYTES,
+    // not per frame
+    size_t new_capacity = capacity_;
+    while (write_offset_ + record_size > new_capacity) {
+        new_capacity += LOG_CHUNK_BYTES;
+    }
+
+    if (map_ != nullptr) {
+        munmap(map_, capacity_);
+        map_ = nullptr;
+    }
+
+    if (ftruncate(fd_, new_capacity) != 0) {
+        std::cerr << "[LOG] ftruncate failed: " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    void* p = mmap(nullptr, new_capacity, PROT_READ | PROT_WRITE,
+                   MAP_SHARED, fd_, 0);
+    if (p == MAP_FAILED) {
+        std::cerr << "[LOG] mmap failed: " << strerror(errno) << std::endl;
+        map_ = nullptr;
+        return false;
+    }
+
+    map_ = static_cast<uint8_t*>(p);
+    capacity_ = new_capacity;
+    return true;
+}
+
+void FrameLogWriter::append(const frame_builder::Frame& frame) {
+    if (frame.soa) {
+        // SoA frames carry per-channel x/y/z vectors and leave xyz_data
+        // empty; the on-disk record is interleaved triplets, so rebuild
+        // them in a reused scratch buffer (recording sits off the rx hot
+        // path, and intensity has no slot in the record format)
+        size_t n = std::min({frame.x_data.size(), frame.y_data.size(),
+                             frame.z_data.size(),
+                             static_cast<size_t>(frame.point_count)});
+        interleave_.resize(n * 3);
+        for (size_t i = 0; i < n; i++) {
+            interleave_[i * 3 + 0] = frame.x_data[i];
+            interleave_[i * 3 + 1] = frame.y_data[i];
+            interleave_[i * 3 + 2] = frame.z_data[i];
+        }
+        append_raw(frame.start_ts_ns, frame.end_ts_ns,
+                   frame.seq_first, frame.seq_last,
+                   frame.pkt_count, frame.sensor_id,
+                   interleave_.data(), n);
+        return;
+    }
+
+    append_raw(frame.start_ts_ns, frame.end_ts_ns,
+               frame.seq_first, frame.seq_last,
+               frame.pkt_count, frame.sensor_id,
+               frame.xyz_data.data(), frame.point_count);
+}
+
+void FrameLogWriter::append_raw(int64_t start_ts_ns, int64_t end_ts_ns,
+                                uint32_t seq_first, uint32_t seq_last,
+                                uint32_t pkt_count, uint16_t sensor_id,
+                                const float* xyz, size_t point_count) {
+    if (fd_ < 0) {
+        return;
+    }
+
+    size_t payload_bytes = point_count * 3 * sizeof(float);
+    size_t record_size = sizeof(FrameRecordHeader) + payload_bytes;
+
+    if (!ensure_capacity(record_size)) {
+        return;  // Disk full / map failure: drop the frame, already logged
+    }
+
+    FrameRecordHeader record;
+    record.magic = RECORD_MAGIC;
+    record.point_count = static_cast<uint32_t>(point_count);
+    record.start_ts_ns = start_ts_ns;
+    record.end_ts_ns = end_ts_ns;
+    record.seq_first = seq_first;
+    record.seq_last = seq_last;
+    record.pkt_count = pkt_count;
+    record.sensor_id = sensor_id;
+    record.reserved = 0;
+
+    uint8_t* dst = map_ + write_offset_;
+    std::memcpy(dst, &record, sizeof(record));
+    std::memcpy(dst + sizeof(record), xyz, payload_bytes);
+
+    index_.push_back({start_ts_ns, static_cast<uint64_t>(write_offset_)});
+    write_offset_ += record_size;
+}
+
+void FrameLogWriter::close() {
+    if (fd_ < 0) {
+        return;
+    }
+
+    if (map_ != nullptr) {
+        munmap(map_, capacity_);
+        map_ = nullptr;
+    }
+
+    // Trim the last partially-used chunk
+    if (ftruncate(fd_, write_offset_) != 0) {
+        std::cerr << "[LOG] Final ftruncate failed: " << strerror(errno) << std::endl;
+    }
+
+    ::close(fd_);
+    fd_ = -1;
+    capacity_ = 0;
+
+    // Write the sidecar index (plain sequential write; small)
+    std::string idx_path = path_ + ".idx";
+    FILE* f = fopen(idx_path.c_str(), "wb");
+    if (f == nullptr) {
+        std::cerr << "[LOG] Failed to write index " << idx_path << ": "
+                  << strerror(errno) << std::endl;
+        return;
+    }
+    if (!index_.empty()) {
+        fwrite(index_.data(), sizeof(IndexEntry), index_.size(), f);
+    }
+    fclose(f);
+}
+
+// ============================================================================
+// FrameLogReader Implementation
+// ============================================================================
+
+FrameLogReader::FrameLogReader(const std::string& path)
+    : path_(path) {}
+
+FrameLogReader::~FrameLogReader() {
+    close();
+}
+
+bool FrameLogReader::open() {
+    if (map_ != nullptr) {
+        return true;  // Already open
+    }
+
+    fd_ = ::open(path_.c_str(), O_RDONLY);
+    if (fd_ < 0) {
+        std::cerr << "[LOG] Failed to open " << path_ << ": "
+                  << strerror(errno) << std::endl;
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd_, &st) != 0 || st.st_size < (off_t)sizeof(LogFileHeader)) {
+        std::cerr << "[LOG] Not a frame log: " << path_ << std::endl;
+        close();
+        return false;
+    }
+    size_ = static_cast<size_t>(st.st_size);
+
+    void* p = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+    if (p == MAP_FAILED) {
+        std::cerr << "[LOG] mmap failed: " << strerror(errno) << std::endl;
+        close();
+        return false;
+    }
+    map_ = static_cast<const uint8_t*>(p);
+
+    LogFileHeader header;
+    std::memcpy(&header, map_, sizeof(header));
+    if (header.magic != LOG_MAGIC || header.version != LOG_VERSION) {
+        std::cerr << "[LOG] Bad log header in " << path_ << std::endl;
+        close();
+        return false;
+    }
+
+    // Sequential read hint: replay walks the file front to back
+    madvise(const_cast<uint8_t*>(map_), size_, MADV_SEQUENTIAL);
+
+    // Load the sidecar index if present, otherwise rebuild by scanning
+    std::string idx_path = path_ + ".idx";
+    FILE* f = fopen(idx_path.c_str(), "rb");
+    if (f != nullptr) {
+        fseek(f, 0, SEEK_END);
+        long idx_size = ftell(f);
+        fseek(f, 0, SEEK_SET);
+        if (idx_size >= 0 && idx_size % sizeof(IndexEntry) == 0) {
+            index_.resize(idx_size / sizeof(IndexEntry));
+            if (!index_.empty() &&
+                fread(index_.data(), sizeof(IndexEntry), index_.size(), f)
+                    != index_.size()) {
+                index_.clear();
+            }
+        }
+        fclose(f);
+    }
+
+    if (index_.empty() && !scan_records()) {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+bool FrameLogReader::scan_records() {
+    index_.clear();
+
+    size_t offset = sizeof(LogFileHeader);
+    while (offset + sizeof(FrameRecordHeader) <= size_) {
+        FrameRecordHeader record;
+        std::memcpy(&record, map_ + offset, sizeof(record));
+
+        if (record.magic != RECORD_MAGIC) {
+            std::cerr << "[LOG] Corrupt record at offset " << offset << std::endl;
+            return !index_.empty();  // Keep what we recovered
+        }
+
+        size_t record_size = sizeof(FrameRecordHeader)
+                           + record.point_count * 3 * sizeof(float);
+        if (offset + record_size > size_) {
+            break;  // Truncated tail (e.g. writer crashed): ignore
+        }
+
+        index_.push_back({record.start_ts_ns, static_cast<uint64_t>(offset)});
+        offset += record_size;
+    }
+
+    return true;
+}
+
+void FrameLogReader::close() {
+    if (map_ != nullptr) {
+        munmap(const_cast<uint8_t*>(map_), size_);
+        map_ = nullptr;
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+    size_ = 0;
+    index_.clear();
+}
+
+const FrameRecordHeader* FrameLogReader::record(size_t i) const {
+    if (map_ == nullptr || i >= index_.size()) {
+        return nullptr;
+    }
+    return reinterpret_cast<const FrameRecordHeader*>(map_ + index_[i].offset);
+}
+
+const float* FrameLogReader::xyz(size_t i) const {
+    const FrameRecordHeader* rec = record(i);
+    if (rec == nullptr) {
+        return nullptr;
+    }
+    return reinterpret_cast<const float*>(
+        reinterpret_cast<const uint8_t*>(rec) + sizeof(FrameRecordHeader));
+}
+
+size_t FrameLogReader::lower_bound_ts(int64_t ts) const {
+    // Index is in append order == timestamp order for a healthy stream
+    size_t lo = 0;
+    size_t hi = index_.size();
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (index_[mid].start_ts_ns < ts) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+} // namespace frame_log
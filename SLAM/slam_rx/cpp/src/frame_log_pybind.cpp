@@ -0,0 +1,157 @@
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include "frame_log_cpp.hpp"
+
+namespace py = pybind11;
+using namespace frame_log;
+
+// ============================================================================
+// Python-compatible wrapper for FrameLogWriter
+// ============================================================================
+
+class FrameLogWriterPy {
+public:
+    explicit FrameLogWriterPy(const std::string& path)
+        : writer_(path) {}
+
+    bool open() { return writer_.open(); }
+    void close() { writer_.close(); }
+    bool is_open() const { return writer_.is_open(); }
+    uint64_t frames_written() const { return writer_.frames_written(); }
+    uint64_t bytes_written() const { return writer_.bytes_written(); }
+
+    // Append one frame from a NumPy (N, 3) array (zero-copy read)
+    void append(int64_t start_ts_ns, int64_t end_ts_ns,
+                py::array_t<float> xyz,
+                uint32_t seq_first, uint32_t seq_last,
+                uint32_t pkt_count, uint16_t sensor_id) {
+        if (xyz.ndim() != 2 || xyz.shape(1) != 3) {
+            throw std::runtime_error("xyz must be (N, 3) array");
+        }
+        writer_.append_raw(start_ts_ns, end_ts_ns, seq_first, seq_last,
+                           pkt_count, sensor_id,
+                           xyz.data(), xyz.shape(0));
+    }
+
+    FrameLogWriter& native() { return writer_; }
+
+private:
+    FrameLogWriter writer_;
+};
+
+// ============================================================================
+// Python-compatible wrapper for FrameLogReader
+// ============================================================================
+
+class FrameLogReaderPy {
+public:
+    explicit FrameLogReaderPy(const std::string& path)
+        : reader_(path) {}
+
+    bool open() { return reader_.open(); }
+    void close() { reader_.close(); }
+    bool is_open() const { return reader_.is_open(); }
+    size_t frame_count() const { return reader_.frame_count(); }
+    size_t lower_bound_ts(int64_t ts) const { return reader_.lower_bound_ts(ts); }
+
+    FrameLogReader& native() { return reader_; }
+
+private:
+    FrameLogReader reader_;
+};
+
+// Build the frame dict for index i with a zero-copy xyz view into the
+// reader's mapping. The array's base is the reader object itself, so the
+// mapping outlives every view handed to Python.
+static py::object reader_frame(py::object self_obj, size_t i) {
+    auto& self = self_obj.cast<FrameLogReaderPy&>();
+    const FrameRecordHeader* rec = self.native().record(i);
+    if (rec == nullptr) {
+        throw py::index_error("frame index out of range");
+    }
+
+    const float* xyz = self.native().xyz(i);
+    std::vector<py::ssize_t> shape = {static_cast<py::ssize_t>(rec->point_count), 3};
+    std::vector<py::ssize_t> strides = {3 * sizeof(float), sizeof(float)};
+
+    // base = reader object: no copy, read-only view into the mmap
+    py::array xyz_array(py::dtype::of<float>(), shape, strides, xyz, self_obj);
+
+    py::dict result;
+    result["xyz"] = xyz_array;
+    result["start_ts_ns"] = rec->start_ts_ns;
+    result["end_ts_ns"] = rec->end_ts_ns;
+    result["seq_first"] = rec->seq_first;
+    result["seq_last"] = rec->seq_last;
+    result["pkt_count"] = rec->pkt_count;
+    result["point_count"] = rec->point_count;
+    result["sensor_id"] = rec->sensor_id;
+    return result;
+}
+
+// ============================================================================
+// pybind11 module definition
+// ============================================================================
+
+PYBIND11_MODULE(frame_log_cpp, m) {
+    m.doc() = "Frame Log - Memory-mapped frame recording and replay";
+
+    py::class_<FrameLogWriterPy>(m, "FrameLogWriter")
+        .def(py::init<const std::string&>(),
+             py::arg("path"),
+             "Initialize writer (call open() before appending)\n\n"
+             "Args:\n"
+             "    path (str): Log file path (sidecar index written to <path>.idx)")
+        .def("open", &FrameLogWriterPy::open,
+             "Create/truncate the log and map the first chunk\n\n"
+             "Returns:\n"
+             "    bool: True on success")
+        .def("append", &FrameLogWriterPy::append,
+             py::arg("start_ts_ns"),
+             py::arg("end_ts_ns"),
+             py::arg("xyz"),
+             py::arg("seq_first") = 0,
+             py::arg("seq_last") = 0,
+             py::arg("pkt_count") = 0,
+             py::arg("sensor_id") = 0,
+             "Append one frame\n\n"
+             "Args:\n"
+             "    start_ts_ns (int): Frame start timestamp (nanoseconds)\n"
+             "    end_ts_ns (int): Frame end timestamp\n"
+             "    xyz (np.ndarray): Point cloud (N, 3) float32\n"
+             "    seq_first/seq_last/pkt_count/sensor_id: Frame metadata")
+        .def("close", &FrameLogWriterPy::close,
+             "Trim the file to the written size and write the index")
+        .def("is_open", &FrameLogWriterPy::is_open)
+        .def("frames_written", &FrameLogWriterPy::frames_written)
+        .def("bytes_written", &FrameLogWriterPy::bytes_written);
+
+    py::class_<FrameLogReaderPy>(m, "FrameLogReader")
+        .def(py::init<const std::string&>(),
+             py::arg("path"),
+             "Initialize reader (call open() before reading)\n\n"
+             "Args:\n"
+             "    path (str): Log file path")
+        .def("open", &FrameLogReaderPy::open,
+             "Map the log read-only and load/rebuild the index\n\n"
+             "Returns:\n"
+             "    bool: True on success")
+        .def("close", &FrameLogReaderPy::close,
+             "Unmap the log (invalidates outstanding frame views)")
+        .def("is_open", &FrameLogReaderPy::is_open)
+        .def("frame_count", &FrameLogReaderPy::frame_count,
+             "Number of frames in the log")
+        .def("__len__", &FrameLogReaderPy::frame_count)
+        .def("frame", &reader_frame,
+             py::arg("i"),
+             "Frame at index i\n\n"
+             "Returns:\n"
+             "    dict: Same keys as live frame_builder frames; 'xyz' is a\n"
+             "        zero-copy read-only view into the mapped log")
+        .def("__getitem__", &reader_frame, py::arg("i"))
+        .def("lower_bound_ts", &FrameLogReaderPy::lower_bound_ts,
+             py::arg("ts_ns"),
+             "Index of the first frame with start_ts_ns >= ts_ns\n\n"
+             "Returns:\n"
+             "    int: Frame index (== frame_count() if none)");
+}
@@ -4,6 +4,10 @@
 #include <iostream>
 #include <zlib.h>
 
+#ifdef HAVE_LZ4
+#include <lz4.h>
+#endif
+
 #ifdef HAVE_ARM_CRC32
 #include <arm_acle.h>
 #endif
@@ -12,6 +16,14 @@
 #include <nmmintrin.h>
 #endif
 
+// SIMD dequantization for v2 packets (compiler-provided baselines:
+// NEON on aarch64, SSE2 on x86_64)
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 // ============================================================================
 // ProtocolStats Implementation
 // ============================================================================
@@ -24,7 +36,12 @@ std::string ProtocolStats::repr() const {
         << ", bad_magic=" << bad_magic
         << ", bad_ver=" << bad_version
         << ", len_err=" << len_mismatch
-        << ", count_err=" << invalid_count << ")";
+        << ", count_err=" << invalid_count
+        << ", compressed=" << compressed_packets
+        << ", decomp_fail=" << decompress_failures
+        << ", fec_parity=" << fec_parity_packets
+        << ", fec_recovered=" << fec_recovered
+        << ", fec_unrecov=" << fec_unrecoverable << ")";
     return oss.str();
 }
 
@@ -115,8 +132,9 @@ uint32_t LidarProtocol::crc32_ieee(const uint8_t* data, size_t length) {
 #endif
 }
 
-// Main parsing function
-std::optional<ParsedPacket> LidarProtocol::parse_datagram(
+// Shared validation: length, magic, version, point count, CRC
+// Updates stats_; returns header pointer or nullptr if invalid
+const PacketHeader* LidarProtocol::validate_datagram(
     const uint8_t* data,
     size_t length,
     bool debug
@@ -130,7 +148,7 @@ std::optional<ParsedPacket> LidarProtocol::parse_datagram(
             std::cerr << "[PROTO] Length too short: " << length
                      << " < " << HEADER_SIZE << std::endl;
         }
-        return std::nullopt;
+        return nullptr;
     }
 
     // 2. Parse header (zero-copy: direct pointer cast)
@@ -144,7 +162,7 @@ std::optional<ParsedPacket> LidarProtocol::parse_datagram(
                      << header->magic << " != 0x" << LIDAR_MAGIC
                      << std::dec << std::endl;
         }
-        return std::nullopt;
+        return nullptr;
     }
 
     // 4. Validate version
@@ -154,30 +172,74 @@ std::optional<ParsedPacket> LidarProtocol::parse_datagram(
             std::cerr << "[PROTO] Bad version: " << (int)header->version
                      << " != " << (int)LIDAR_VERSION << std::endl;
         }
-        return std::nullopt;
+        return nullptr;
+    }
+
+    // FEC parity packets have their own layout (FecBlock + XOR bytes);
+    // point_count carries the XOR byte length, not a point count
+    if (header->flags & FLAG_FEC_PARITY) {
+        size_t expected = HEADER_SIZE + FEC_BLOCK_SIZE + header->point_count;
+        if (length != expected || expected > MAX_UDP_PAYLOAD) {
+            stats_.len_mismatch++;
+            if (debug) {
+                std::cerr << "[PROTO] Parity length mismatch: " << length
+                         << " vs expected " << expected << std::endl;
+            }
+            return nullptr;
+        }
+        if (validate_crc_ && header->crc32 != 0) {
+            uint32_t crc = ::crc32(0, data, 23);
+            crc = ::crc32(crc, data + HEADER_SIZE, length - HEADER_SIZE);
+            if (crc != header->crc32) {
+                stats_.crc_failures++;
+                if (debug) {
+                    std::cerr << "[PROTO] Parity CRC mismatch" << std::endl;
+                }
+                return nullptr;
+            }
+        }
+        return header;
     }
 
+    // Quantized (v2) payloads have a different layout and capacity
+    const bool quantized = (header->flags & FLAG_QUANT_POINTS) != 0;
+    const size_t max_points = quantized ? MAX_QUANT_POINTS_PER_PACKET
+                                        : MAX_POINTS_PER_PACKET;
+
     // 5. Validate point count
-    if (header->point_count < 1 || header->point_count > MAX_POINTS_PER_PACKET) {
+    if (header->point_count < 1 || header->point_count > max_points) {
         stats_.invalid_count++;
         if (debug) {
             std::cerr << "[PROTO] Invalid point_count: " << header->point_count
-                     << " (valid: 1-" << MAX_POINTS_PER_PACKET << ")" << std::endl;
+                     << " (valid: 1-" << max_points << ")" << std::endl;
         }
-        return std::nullopt;
+        return nullptr;
     }
 
     // 6. Validate total length
-    size_t expected_len = HEADER_SIZE + header->point_count * POINT_SIZE;
-    if (length != expected_len) {
+    // Compressed payloads are variable-length (always smaller than the raw
+    // layout -- the transmitter falls back to raw otherwise); the exact
+    // size is verified by decompression. A latency-probe trailer adds a
+    // fixed 8 bytes after the (possibly compressed) point payload.
+    const bool compressed = (header->flags & FLAG_COMPRESSED_LZ4) != 0;
+    const size_t trailer = (header->flags & FLAG_HOST_TS)
+        ? HOST_TS_TRAILER_SIZE : 0;
+    size_t expected_len = (quantized
+        ? HEADER_SIZE + QUANT_BLOCK_SIZE + header->point_count * QUANT_POINT_SIZE
+        : HEADER_SIZE + header->point_count * POINT_SIZE) + trailer;
+    bool len_ok = compressed
+        ? (length > HEADER_SIZE + trailer && length <= expected_len)
+        : (length == expected_len);
+    if (!len_ok) {
         stats_.len_mismatch++;
         if (debug) {
             std::cerr << "[PROTO] Length mismatch: " << length
-                     << " != " << expected_len << " (header=" << HEADER_SIZE
-                     << " + " << header->point_count << "×" << POINT_SIZE
-                     << ")" << std::endl;
+                     << " vs expected " << expected_len << " (header=" << HEADER_SIZE
+                     << " + " << header->point_count << " points"
+                     << (quantized ? ", quantized" : "")
+                     << (compressed ? ", compressed" : "") << ")" << std::endl;
         }
-        return std::nullopt;
+        return nullptr;
     }
 
     // 7. CRC validation (if enabled and CRC != 0)
@@ -186,9 +248,10 @@ std::optional<ParsedPacket> LidarProtocol::parse_datagram(
         // Use zlib crc32 for IEEE 802.3 compatibility (NOT ARM CRC32C hardware)
         uint32_t calculated_crc = ::crc32(0, data, 23);  // First 23 bytes
 
-        // Continue with payload after CRC field
+        // Continue with payload after CRC field (length already validated,
+        // so this covers the quant block too in v2 packets)
         const uint8_t* payload = data + HEADER_SIZE;
-        size_t payload_len = header->point_count * POINT_SIZE;
+        size_t payload_len = length - HEADER_SIZE;
         calculated_crc = ::crc32(calculated_crc, payload, payload_len);
 
         if (calculated_crc != header->crc32) {
@@ -198,10 +261,374 @@ std::optional<ParsedPacket> LidarProtocol::parse_datagram(
                          << calculated_crc << " != received=0x" << header->crc32
                          << std::dec << std::endl;
             }
-            return std::nullopt;
+            return nullptr;
         }
     }
 
+    return header;
+}
+
+// ============================================================================
+// XOR Parity FEC Recovery
+// ============================================================================
+
+// Buffer a validated data datagram so a later parity packet can use it for
+// reconstruction. No-op until the first parity packet allocates the window.
+void LidarProtocol::fec_store(
+    const PacketHeader* header,
+    const uint8_t* data,
+    size_t length
+) {
+    if (!fec_window_) {
+        return;
+    }
+
+    FecSlot& slot = fec_window_[header->seq & (FEC_WINDOW - 1)];
+    slot.valid = true;
+    slot.seq = header->seq;
+    slot.length = (uint16_t)length;
+    std::memcpy(slot.data, data, length);
+}
+
+// Process a validated parity packet: if exactly one member of the protected
+// group seq..seq+k-1 is missing from the window, rebuild its datagram by
+// XORing the parity payload and recovery fields with the received members.
+// The rebuilt header carries crc32 = 0 (skipped by validation): the parity
+// packet's own CRC already covered the recovered bytes.
+size_t LidarProtocol::fec_process_parity(
+    const PacketHeader* header,
+    const uint8_t* data,
+    uint8_t* out,
+    bool debug
+) {
+    stats_.fec_parity_packets++;
+
+    if (!fec_window_) {
+        // First parity packet: start buffering from here on. The group it
+        // protects predates the window, so it cannot recover anything.
+        fec_window_.reset(new FecSlot[FEC_WINDOW]);
+        return 0;
+    }
+
+    FecBlock fec;
+    std::memcpy(&fec, data + HEADER_SIZE, FEC_BLOCK_SIZE);
+    if (fec.k < 2 || fec.k > FEC_MAX_K) {
+        stats_.invalid_count++;
+        if (debug) {
+            std::cerr << "[PROTO] Parity group size out of range: "
+                     << (int)fec.k << std::endl;
+        }
+        return 0;
+    }
+
+    // Locate the single missing group member (if any)
+    const uint32_t base = header->seq;
+    int missing = -1;
+    for (int i = 0; i < fec.k; i++) {
+        const uint32_t s = base + i;
+        const FecSlot& slot = fec_window_[s & (FEC_WINDOW - 1)];
+        if (!slot.valid || slot.seq != s) {
+            if (missing >= 0) {
+                stats_.fec_unrecoverable++;
+                if (debug) {
+                    std::cerr << "[PROTO] Parity group " << base
+                             << ": >1 packet lost, cannot recover" << std::endl;
+                }
+                return 0;
+            }
+            missing = i;
+        }
+    }
+    if (missing < 0) {
+        return 0;  // Whole group arrived: nothing to recover
+    }
+
+    // Reconstruct: start from the parity XOR and fold in each received member
+    const size_t xor_len = header->point_count;
+    uint64_t ts = header->device_ts_ns;
+    uint16_t count = fec.xor_point_count;
+    uint16_t flags = fec.xor_flags;
+    uint16_t payload_len = fec.xor_len;
+
+    uint8_t* payload = out + HEADER_SIZE;
+    std::memcpy(payload, data + HEADER_SIZE + FEC_BLOCK_SIZE, xor_len);
+
+    for (int i = 0; i < fec.k; i++) {
+        if (i == missing) {
+            continue;
+        }
+        const FecSlot& slot = fec_window_[(base + i) & (FEC_WINDOW - 1)];
+
+        PacketHeader mh;
+        std::memcpy(&mh, slot.data, HEADER_SIZE);
+        ts ^= mh.device_ts_ns;
+        count ^= mh.point_count;
+        flags ^= mh.flags;
+        payload_len ^= (uint16_t)(slot.length - HEADER_SIZE);
+
+        const size_t mlen = slot.length - HEADER_SIZE;
+        for (size_t b = 0; b < mlen; b++) {
+            payload[b] ^= slot.data[HEADER_SIZE + b];
+        }
+    }
+
+    if (payload_len == 0 || payload_len > xor_len ||
+        HEADER_SIZE + payload_len > MAX_UDP_PAYLOAD) {
+        stats_.fec_unrecoverable++;
+        if (debug) {
+            std::cerr << "[PROTO] Parity group " << base
+                     << ": recovered length " << payload_len
+                     << " implausible" << std::endl;
+        }
+        return 0;
+    }
+
+    PacketHeader rebuilt;
+    rebuilt.magic = LIDAR_MAGIC;
+    rebuilt.version = LIDAR_VERSION;
+    rebuilt.device_ts_ns = ts;
+    rebuilt.seq = base + missing;
+    rebuilt.point_count = count;
+    rebuilt.flags = flags;
+    rebuilt.sensor_id = header->sensor_id;
+    rebuilt.crc32 = 0;
+    std::memcpy(out, &rebuilt, HEADER_SIZE);
+
+    stats_.fec_recovered++;
+    if (debug) {
+        std::cout << "[PROTO] ✓ FEC recovered seq=" << rebuilt.seq
+                 << " (" << count << " points)" << std::endl;
+    }
+
+    return HEADER_SIZE + payload_len;
+}
+
+// ============================================================================
+// v2 Dequantization Kernel
+// ============================================================================
+
+// Dequantize n 7-byte records at src back to interleaved float32 XYZ.
+//
+// SIMD path: coordinates of 4 points are gathered into a contiguous int16
+// staging block, then widened, converted, and scaled 12 lanes at a time.
+// The interleaved x,y,z,x,... layout is handled with three rotated offset
+// vectors (the pattern repeats every 12 floats).
+static void dequantize_xyz(const QuantBlock& block, const uint8_t* src,
+                           size_t n, float* out) {
+    const float ox = block.offset_x;
+    const float oy = block.offset_y;
+    const float oz = block.offset_z;
+    const float scale = block.scale;
+
+    size_t i = 0;
+
+#if defined(__ARM_NEON)
+    const float32x4_t vscale = vdupq_n_f32(scale);
+    const float off0[4] = {ox, oy, oz, ox};
+    const float off1[4] = {oy, oz, ox, oy};
+    const float off2[4] = {oz, ox, oy, oz};
+    const float32x4_t voff0 = vld1q_f32(off0);
+    const float32x4_t voff1 = vld1q_f32(off1);
+    const float32x4_t voff2 = vld1q_f32(off2);
+
+    int16_t q[12];
+    for (; i + 4 <= n; i += 4) {
+        for (size_t k = 0; k < 4; k++) {
+            std::memcpy(&q[k * 3], src + (i + k) * QUANT_POINT_SIZE, 6);
+        }
+
+        int16x8_t q07 = vld1q_s16(q);
+        int16x4_t q811 = vld1_s16(q + 8);
+
+        float32x4_t f0 = vcvtq_f32_s32(vmovl_s16(vget_low_s16(q07)));
+        float32x4_t f1 = vcvtq_f32_s32(vmovl_s16(vget_high_s16(q07)));
+        float32x4_t f2 = vcvtq_f32_s32(vmovl_s16(q811));
+
+        vst1q_f32(out + i * 3,     vmlaq_f32(voff0, f0, vscale));
+        vst1q_f32(out + i * 3 + 4, vmlaq_f32(voff1, f1, vscale));
+        vst1q_f32(out + i * 3 + 8, vmlaq_f32(voff2, f2, vscale));
+    }
+#elif defined(__SSE2__)
+    const __m128 vscale = _mm_set1_ps(scale);
+    const __m128 voff0 = _mm_setr_ps(ox, oy, oz, ox);
+    const __m128 voff1 = _mm_setr_ps(oy, oz, ox, oy);
+    const __m128 voff2 = _mm_setr_ps(oz, ox, oy, oz);
+
+    int16_t q[12];
+    for (; i + 4 <= n; i += 4) {
+        for (size_t k = 0; k < 4; k++) {
+            std::memcpy(&q[k * 3], src + (i + k) * QUANT_POINT_SIZE, 6);
+        }
+
+        // Sign-extend int16 -> int32 (SSE2 has no cvtepi16: interleave
+        // with the arithmetic-shift sign mask instead)
+        __m128i q07 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(q));
+        __m128i q811 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(q + 8));
+        __m128i sign07 = _mm_srai_epi16(q07, 15);
+        __m128i sign811 = _mm_srai_epi16(q811, 15);
+
+        __m128 f0 = _mm_cvtepi32_ps(_mm_unpacklo_epi16(q07, sign07));
+        __m128 f1 = _mm_cvtepi32_ps(_mm_unpackhi_epi16(q07, sign07));
+        __m128 f2 = _mm_cvtepi32_ps(_mm_unpacklo_epi16(q811, sign811));
+
+        _mm_storeu_ps(out + i * 3,     _mm_add_ps(voff0, _mm_mul_ps(f0, vscale)));
+        _mm_storeu_ps(out + i * 3 + 4, _mm_add_ps(voff1, _mm_mul_ps(f1, vscale)));
+        _mm_storeu_ps(out + i * 3 + 8, _mm_add_ps(voff2, _mm_mul_ps(f2, vscale)));
+    }
+#endif
+
+    // Scalar tail (and full fallback without SIMD)
+    for (; i < n; i++) {
+        QuantPoint qp;
+        std::memcpy(&qp, src + i * QUANT_POINT_SIZE, QUANT_POINT_SIZE);
+        out[i * 3]     = ox + qp.x * scale;
+        out[i * 3 + 1] = oy + qp.y * scale;
+        out[i * 3 + 2] = oz + qp.z * scale;
+    }
+}
+
+// Resolve the point payload for a validated datagram.
+// Uncompressed: returns the in-place payload. Compressed: LZ4-decompresses
+// into scratch and cross-checks the size implied by point_count + encoding.
+const uint8_t* LidarProtocol::decode_payload(
+    const PacketHeader* header,
+    const uint8_t* data,
+    size_t length,
+    uint8_t* scratch,
+    bool debug
+) {
+    if (!(header->flags & FLAG_COMPRESSED_LZ4)) {
+        return data + HEADER_SIZE;
+    }
+
+#ifdef HAVE_LZ4
+    size_t raw_len = (header->flags & FLAG_QUANT_POINTS)
+        ? QUANT_BLOCK_SIZE + header->point_count * QUANT_POINT_SIZE
+        : header->point_count * POINT_SIZE;
+
+    // The latency-probe trailer sits after the compressed bytes
+    const size_t trailer = (header->flags & FLAG_HOST_TS)
+        ? HOST_TS_TRAILER_SIZE : 0;
+
+    int decoded = LZ4_decompress_safe(
+        reinterpret_cast<const char*>(data + HEADER_SIZE),
+        reinterpret_cast<char*>(scratch),
+        static_cast<int>(length - HEADER_SIZE - trailer),
+        static_cast<int>(raw_len)
+    );
+
+    if (decoded != static_cast<int>(raw_len)) {
+        stats_.decompress_failures++;
+        if (debug) {
+            std::cerr << "[PROTO] LZ4 decompress failed: " << decoded
+                     << " != " << raw_len << std::endl;
+        }
+        return nullptr;
+    }
+
+    stats_.compressed_packets++;
+    return scratch;
+#else
+    (void)length;
+    (void)scratch;
+    stats_.decompress_failures++;
+    if (debug) {
+        std::cerr << "[PROTO] Compressed packet but built without LZ4" << std::endl;
+    }
+    return nullptr;
+#endif
+}
+
+// Decode one validated packet's point payload onto the output arrays
+// (shared by parse_datagram and parse_datagrams)
+void LidarProtocol::append_points(
+    const PacketHeader* header,
+    const uint8_t* payload,
+    std::vector<float>& points_data,
+    std::vector<float>& xyz_data
+) {
+    const size_t n = header->point_count;
+
+    if (header->flags & FLAG_QUANT_POINTS) {
+        // v2: dequantize straight into the xyz array (SIMD kernel)
+        QuantBlock block;
+        std::memcpy(&block, payload, QUANT_BLOCK_SIZE);
+        const uint8_t* qpoints = payload + QUANT_BLOCK_SIZE;
+
+        size_t xyz_base = xyz_data.size();
+        xyz_data.resize(xyz_base + n * 3);
+        dequantize_xyz(block, qpoints, n, xyz_data.data() + xyz_base);
+
+        // (N, 4) view: dequantized xyz + intensity
+        size_t pts_base = points_data.size();
+        points_data.resize(pts_base + n * 4);
+        float* dst = points_data.data() + pts_base;
+        const float* xyz = xyz_data.data() + xyz_base;
+
+        for (size_t i = 0; i < n; i++) {
+            dst[i * 4]     = xyz[i * 3];
+            dst[i * 4 + 1] = xyz[i * 3 + 1];
+            dst[i * 4 + 2] = xyz[i * 3 + 2];
+            dst[i * 4 + 3] = static_cast<float>(qpoints[i * QUANT_POINT_SIZE + 6]);
+        }
+        return;
+    }
+
+    // v1: zero-copy float pass-through
+    const Point* points = reinterpret_cast<const Point*>(payload);
+
+    for (size_t i = 0; i < n; i++) {
+        const Point& pt = points[i];
+
+        points_data.push_back(pt.x);
+        points_data.push_back(pt.y);
+        points_data.push_back(pt.z);
+        points_data.push_back(static_cast<float>(pt.intensity));
+
+        xyz_data.push_back(pt.x);
+        xyz_data.push_back(pt.y);
+        xyz_data.push_back(pt.z);
+    }
+}
+
+// Main parsing function
+std::optional<ParsedPacket> LidarProtocol::parse_datagram(
+    const uint8_t* data,
+    size_t length,
+    bool debug
+) {
+    // 1-7. Header/length/CRC validation
+    const PacketHeader* header = validate_datagram(data, length, debug);
+    if (header == nullptr) {
+        return std::nullopt;
+    }
+
+    // Parity packet: not a point packet. If it can rebuild a lost group
+    // member, the recovered datagram is parsed in its place.
+    if (header->flags & FLAG_FEC_PARITY) {
+        uint8_t recovered[MAX_UDP_PAYLOAD];
+        size_t rec_len = fec_process_parity(header, data, recovered, debug);
+        if (rec_len > 0) {
+            auto parsed = parse_datagram(recovered, rec_len, debug);
+            // The recovered datagram never arrived on the wire (it is
+            // already counted in fec_recovered), so undo the total_packets
+            // bump its re-validation made: valid/total stays a delivery
+            // ratio
+            stats_.total_packets--;
+            return parsed;
+        }
+        return std::nullopt;
+    }
+
+    fec_store(header, data, length);
+
+    // Resolve payload (LZ4-decompress if flagged)
+    uint8_t scratch[MAX_UDP_PAYLOAD];
+    const uint8_t* payload = decode_payload(header, data, length, scratch, debug);
+    if (payload == nullptr) {
+        return std::nullopt;
+    }
+
     // 8. Parse points (single pass, direct memory access)
     ParsedPacket result;
     result.device_ts_ns = header->device_ts_ns;
@@ -210,29 +637,18 @@ std::optional<ParsedPacket> LidarProtocol::parse_datagram(
     result.sensor_id = header->sensor_id;
     result.flags = header->flags;
     result.crc32 = header->crc32;
+    if (header->flags & FLAG_HOST_TS) {
+        std::memcpy(&result.host_send_ns, data + length - HOST_TS_TRAILER_SIZE,
+                    HOST_TS_TRAILER_SIZE);
+    }
 
     // Pre-allocate arrays
     size_t n_points = header->point_count;
     result.points_data.reserve(n_points * 4);  // x, y, z, intensity
     result.xyz_data.reserve(n_points * 3);     // x, y, z only
 
-    // Zero-copy point parsing
-    const Point* points = reinterpret_cast<const Point*>(data + HEADER_SIZE);
-
-    for (size_t i = 0; i < n_points; i++) {
-        const Point& pt = points[i];
-
-        // points array: (N, 4)
-        result.points_data.push_back(pt.x);
-        result.points_data.push_back(pt.y);
-        result.points_data.push_back(pt.z);
-        result.points_data.push_back(static_cast<float>(pt.intensity));
-
-        // xyz array: (N, 3)
-        result.xyz_data.push_back(pt.x);
-        result.xyz_data.push_back(pt.y);
-        result.xyz_data.push_back(pt.z);
-    }
+    // Decode points (raw v1 or quantized v2 payload)
+    append_points(header, payload, result.points_data, result.xyz_data);
 
     stats_.valid_packets++;
 
@@ -246,3 +662,94 @@ std::optional<ParsedPacket> LidarProtocol::parse_datagram(
 
     return result;
 }
+
+// Batch parsing: one call per datagram burst
+//
+// Validates and parses every datagram in the burst, appending points into
+// one pair of concatenated arrays. Invalid datagrams are skipped and
+// counted in stats_ exactly as in parse_datagram(). Designed to run with
+// the Python GIL released and cross the pybind boundary once per burst.
+ParsedBatch LidarProtocol::parse_datagrams(
+    const uint8_t* const* datagrams,
+    const size_t* lengths,
+    size_t count,
+    bool debug
+) {
+    ParsedBatch batch;
+
+    // Pre-size for the common case: full 105-point packets
+    batch.points_data.reserve(count * MAX_POINTS_PER_PACKET * 4);
+    batch.xyz_data.reserve(count * MAX_POINTS_PER_PACKET * 3);
+    batch.device_ts_ns.reserve(count);
+    batch.seq.reserve(count);
+    batch.point_counts.reserve(count);
+    batch.sensor_ids.reserve(count);
+    batch.host_send_ns.reserve(count);
+
+    uint8_t scratch[MAX_UDP_PAYLOAD];
+    uint8_t recovered[MAX_UDP_PAYLOAD];
+
+    for (size_t d = 0; d < count; d++) {
+        const uint8_t* dgram = datagrams[d];
+        size_t dlen = lengths[d];
+
+        const PacketHeader* header = validate_datagram(dgram, dlen, debug);
+        if (header == nullptr) {
+            continue;  // Invalid datagram: already counted in stats_
+        }
+
+        // Parity packet: parse a recovered group member in its place
+        if (header->flags & FLAG_FEC_PARITY) {
+            size_t rec_len = fec_process_parity(header, dgram, recovered, debug);
+            if (rec_len == 0) {
+                continue;
+            }
+            dgram = recovered;
+            dlen = rec_len;
+            header = validate_datagram(dgram, dlen, debug);
+            // Undo the total_packets bump for the synthetic datagram: it
+            // never arrived on the wire and is already in fec_recovered
+            stats_.total_packets--;
+            if (header == nullptr) {
+                continue;
+            }
+        }
+
+        fec_store(header, dgram, dlen);
+
+        // Resolve payload (LZ4-decompress if flagged)
+        const uint8_t* payload = decode_payload(header, dgram, dlen,
+                                                scratch, debug);
+        if (payload == nullptr) {
+            continue;  // Decompression failed: counted in stats_
+        }
+
+        // Append per-packet metadata
+        batch.device_ts_ns.push_back(header->device_ts_ns);
+        batch.seq.push_back(header->seq);
+        batch.point_counts.push_back(header->point_count);
+        batch.sensor_ids.push_back(header->sensor_id);
+        uint64_t host_ns = 0;
+        if (header->flags & FLAG_HOST_TS) {
+            std::memcpy(&host_ns, dgram + dlen - HOST_TS_TRAILER_SIZE,
+                        HOST_TS_TRAILER_SIZE);
+        }
+        batch.host_send_ns.push_back(host_ns);
+
+        // Append points to the concatenated arrays (raw v1 or quantized v2)
+        size_t n_points = header->point_count;
+        append_points(header, payload, batch.points_data, batch.xyz_data);
+
+        batch.packet_count++;
+        batch.total_points += n_points;
+        stats_.valid_packets++;
+    }
+
+    if (debug) {
+        std::cout << "[PROTO] ✓ Batch: " << batch.packet_count << "/" << count
+                 << " valid packets, " << batch.total_points << " points"
+                 << std::endl;
+    }
+
+    return batch;
+}
@@ -0,0 +1,581 @@
+#include "lidar_rx_cpp.hpp"
+#include "latency_histogram.hpp"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <sstream>
+
+namespace lidar_rx {
+
+// Receive buffer: one datagram (max 1400B payload) with headroom
+static constexpr size_t RECV_BUFFER_SIZE = 2048;
+
+// Datagrams pulled per recvmmsg() syscall (~4000 syscalls/sec saved at
+// full packet rate versus one recv() per datagram)
+static constexpr unsigned RECV_BURST = 64;
+
+// Receive timeout so the loop can notice stop() on an idle link
+static constexpr int RECV_TIMEOUT_MS = 100;
+
+// Socket receive buffer (matches the Python receiver's setting)
+static constexpr int SOCKET_RCVBUF_BYTES = 4 * 1024 * 1024;
+
+// Parse-stage latency (same registry as the frame builder's stages, so
+// one SIGUSR1 dump covers the whole rx pipeline)
+static latency::LatencyHistogram* const g_parse_hist = latency::stage("parse");
+
+// Inter-packet arrival gaps from kernel SO_TIMESTAMPNS stamps: honest
+// arrival timing for gap forensics, unskewed by userspace scheduling
+static latency::LatencyHistogram* const g_arrival_hist =
+    latency::stage("arrival_gap");
+
+// ============================================================================
+// RxStats implementation
+// ============================================================================
+
+void RxStats::reset() {
+    datagrams_received = 0;
+    bytes_received = 0;
+    recv_timeouts = 0;
+    frames_queued = 0;
+    queue_drops = 0;
+    frames_recorded = 0;
+    recvmmsg_calls = 0;
+    burst_max = 0;
+    echoes_sent = 0;
+}
+
+std::string RxStats::repr() const {
+    std::ostringstream oss;
+    oss << "RxStats(datagrams=" << datagrams_received
+        << ", bytes=" << bytes_received
+        << ", timeouts=" << recv_timeouts
+        << ", frames=" << frames_queued
+        << ", drops=" << queue_drops
+        << ", recorded=" << frames_recorded
+        << ", bursts=" << recvmmsg_calls
+        << ", burst_max=" << burst_max
+        << ", echoes=" << echoes_sent << ")";
+    return oss.str();
+}
+
+// ============================================================================
+// LidarReceiver implementation
+// ============================================================================
+
+LidarReceiver::LidarReceiver(const std::string& bind_ip,
+                             uint16_t port,
+                             double frame_period_s,
+                             size_t max_frame_points,
+                             bool validate_crc,
+                             size_t queue_capacity,
+                             double voxel_size,
+                             const std::string& record_path,
+                             int telemetry_port,
+                             int echo_sample)
+    : LidarReceiver(bind_ip, std::vector<uint16_t>{port}, frame_period_s,
+                    max_frame_points, validate_crc, queue_capacity,
+                    voxel_size, record_path, telemetry_port, echo_sample)
+{
+}
+
+LidarReceiver::LidarReceiver(const std::string& bind_ip,
+                             std::vector<uint16_t> ports,
+                             double frame_period_s,
+                             size_t max_frame_points,
+                             bool validate_crc,
+                             size_t queue_capacity,
+                             double voxel_size,
+                             const std::string& record_path,
+                             int telemetry_port,
+                             int echo_sample)
+    : bind_ip_(bind_ip)
+    , queue_capacity_(queue_capacity)
+    , record_path_(record_path)
+    , telemetry_port_(telemetry_port)
+    , echo_sample_(echo_sample)
+    , running_(false)
+{
+    for (uint16_t port : ports) {
+        workers_.emplace_back(new Worker(port, validate_crc, frame_period_s,
+                                         max_frame_points, voxel_size));
+    }
+}
+
+LidarReceiver::~LidarReceiver() {
+    stop();
+}
+
+bool LidarReceiver::open_socket(Worker& worker) {
+    // Create UDP socket
+    worker.sock_fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (worker.sock_fd < 0) {
+        std::cerr << "[RX] Failed to create socket: " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    // Allow quick restart on the same port
+    int reuse = 1;
+    setsockopt(worker.sock_fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    // Large receive buffer to absorb bursts
+    int rcvbuf = SOCKET_RCVBUF_BYTES;
+    setsockopt(worker.sock_fd, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+
+    // Receive timeout so rx_loop can observe stop()
+    struct timeval timeout;
+    timeout.tv_sec = RECV_TIMEOUT_MS / 1000;
+    timeout.tv_usec = (RECV_TIMEOUT_MS % 1000) * 1000;
+    setsockopt(worker.sock_fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    // Kernel receive timestamps (per-packet, delivered via cmsg)
+    int ts_on = 1;
+    if (setsockopt(worker.sock_fd, SOL_SOCKET, SO_TIMESTAMPNS, &ts_on,
+                   sizeof(ts_on)) < 0) {
+        std::cerr << "[RX] SO_TIMESTAMPNS unavailable: arrival-gap stats disabled"
+                  << std::endl;  // Non-fatal: the stream still runs
+    }
+
+    // Bind
+    struct sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(worker.port);
+    if (inet_pton(AF_INET, bind_ip_.c_str(), &addr.sin_addr) <= 0) {
+        std::cerr << "[RX] Invalid bind IP: " << bind_ip_ << std::endl;
+        close(worker.sock_fd);
+        worker.sock_fd = -1;
+        return false;
+    }
+
+    if (bind(worker.sock_fd, reinterpret_cast<struct sockaddr*>(&addr),
+             sizeof(addr)) < 0) {
+        std::cerr << "[RX] Failed to bind " << bind_ip_ << ":" << worker.port
+                  << ": " << strerror(errno) << std::endl;
+        close(worker.sock_fd);
+        worker.sock_fd = -1;
+        return false;
+    }
+
+    return true;
+}
+
+bool LidarReceiver::start() {
+    if (running_.load(std::memory_order_relaxed)) {
+        return true;  // Already running
+    }
+
+    // Open every worker's socket before starting any thread, so a bind
+    // failure on one port leaves nothing half-running
+    for (size_t i = 0; i < workers_.size(); i++) {
+        if (!open_socket(*workers_[i])) {
+            for (size_t j = 0; j < i; j++) {
+                close(workers_[j]->sock_fd);
+                workers_[j]->sock_fd = -1;
+            }
+            return false;
+        }
+    }
+
+    // Optional frame recording (non-fatal: stream without it on failure)
+    if (!record_path_.empty()) {
+        recorder_.reset(new frame_log::FrameLogWriter(record_path_));
+        if (!recorder_->open()) {
+            std::cerr << "[RX] Recording disabled (could not open "
+                      << record_path_ << ")" << std::endl;
+            recorder_.reset();
+        }
+    }
+
+    // Optional telemetry endpoint (non-fatal: stream without it on failure)
+    if (telemetry_port_ > 0) {
+        bool ok = telemetry_.start(
+            (uint16_t)telemetry_port_,
+            [this](char* buf, size_t cap) {
+                return telemetry_snapshot(buf, cap);
+            });
+        if (!ok) {
+            std::cerr << "[RX] Telemetry disabled (could not bind port "
+                      << telemetry_port_ << ")" << std::endl;
+        }
+    }
+
+    // kill -USR1 dumps live stage latency percentiles to stderr
+    latency::install_sigusr1_dump();
+
+    // Start one receive thread per worker
+    running_.store(true, std::memory_order_relaxed);
+    for (auto& worker : workers_) {
+        worker->thread = std::thread(&LidarReceiver::rx_loop, this,
+                                     std::ref(*worker));
+    }
+
+    return true;
+}
+
+void LidarReceiver::stop() {
+    if (!running_.exchange(false, std::memory_order_relaxed)) {
+        // Not running: still join finished threads if needed
+        for (auto& worker : workers_) {
+            if (worker->thread.joinable()) {
+                worker->thread.join();
+            }
+        }
+        return;
+    }
+
+    for (auto& worker : workers_) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+
+    telemetry_.stop();
+
+    for (auto& worker : workers_) {
+        if (worker->sock_fd >= 0) {
+            close(worker->sock_fd);
+            worker->sock_fd = -1;
+        }
+    }
+
+    // Finalize the frame log (trim + index)
+    if (recorder_) {
+        recorder_->close();
+        recorder_.reset();
+    }
+
+    // Wake any Python thread blocked in pop_frame()
+    queue_cv_.notify_all();
+}
+
+std::optional<frame_builder::Frame> LidarReceiver::pop_frame(double timeout_s) {
+    std::unique_lock<std::mutex> lock(queue_mutex_);
+
+    if (frame_queue_.empty()) {
+        auto timeout = std::chrono::duration<double>(timeout_s);
+        queue_cv_.wait_for(lock, timeout, [this] {
+            return !frame_queue_.empty() ||
+                   !running_.load(std::memory_order_relaxed);
+        });
+    }
+
+    if (frame_queue_.empty()) {
+        return std::nullopt;  // Timeout or stopped
+    }
+
+    frame_builder::Frame frame = std::move(frame_queue_.front());
+    frame_queue_.pop_front();
+    return frame;
+}
+
+size_t LidarReceiver::queue_depth() {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    return frame_queue_.size();
+}
+
+// Aggregated stats: plain sums of the per-worker counters (burst_max
+// takes the max). Same snapshot semantics as before: single-writer
+// counters read without synchronization.
+
+ProtocolStats LidarReceiver::protocol_stats() const {
+    ProtocolStats total;
+    for (const auto& worker : workers_) {
+        const ProtocolStats& s = worker->protocol.stats();
+        total.total_packets += s.total_packets;
+        total.valid_packets += s.valid_packets;
+        total.crc_failures += s.crc_failures;
+        total.bad_magic += s.bad_magic;
+        total.bad_version += s.bad_version;
+        total.len_mismatch += s.len_mismatch;
+        total.invalid_count += s.invalid_count;
+        total.compressed_packets += s.compressed_packets;
+        total.decompress_failures += s.decompress_failures;
+        total.fec_parity_packets += s.fec_parity_packets;
+        total.fec_recovered += s.fec_recovered;
+        total.fec_unrecoverable += s.fec_unrecoverable;
+    }
+    return total;
+}
+
+frame_builder::FrameBuilderStats LidarReceiver::frame_stats() const {
+    frame_builder::FrameBuilderStats total;
+    for (const auto& worker : workers_) {
+        const frame_builder::FrameBuilderStats& s = worker->fb_stats;
+        total.frames_built += s.frames_built;
+        total.packets_added += s.packets_added;
+        total.points_added += s.points_added;
+        total.late_packets += s.late_packets;
+        total.seq_gaps += s.seq_gaps;
+        total.seq_reorders += s.seq_reorders;
+        total.overflow_frames += s.overflow_frames;
+        total.voxel_dropped += s.voxel_dropped;
+        total.deskewed_points += s.deskewed_points;
+        total.add_to_frame_calls += s.add_to_frame_calls;
+        total.close_frame_calls += s.close_frame_calls;
+        total.memcpy_calls += s.memcpy_calls;
+        total.memcpy_bytes += s.memcpy_bytes;
+    }
+    return total;
+}
+
+RxStats LidarReceiver::rx_stats() const {
+    RxStats total;
+    for (const auto& worker : workers_) {
+        const RxStats& s = worker->rx_stats;
+        total.datagrams_received += s.datagrams_received;
+        total.bytes_received += s.bytes_received;
+        total.recv_timeouts += s.recv_timeouts;
+        total.frames_queued += s.frames_queued;
+        total.queue_drops += s.queue_drops;
+        total.frames_recorded += s.frames_recorded;
+        total.recvmmsg_calls += s.recvmmsg_calls;
+        if (s.burst_max > total.burst_max) {
+            total.burst_max = s.burst_max;
+        }
+        total.echoes_sent += s.echoes_sent;
+    }
+    return total;
+}
+
+size_t LidarReceiver::telemetry_snapshot(char* buf, size_t cap) const {
+    // Plain-struct reads, same snapshot semantics as the stats() accessors:
+    // single-writer counters read without synchronization
+    using telemetry::append;
+
+    const ProtocolStats ps = protocol_stats();
+    const frame_builder::FrameBuilderStats fs = frame_stats();
+    const RxStats rs = rx_stats();
+
+#define LLU(v) (unsigned long long)(v)
+    size_t off = 0;
+    off = append(buf, cap, off, "{\"role\":\"rx\",\"workers\":%llu,",
+                 LLU(workers_.size()));
+    off = append(buf, cap, off,
+                 "\"protocol\":{\"total_packets\":%llu,\"valid_packets\":%llu,"
+                 "\"crc_failures\":%llu,\"bad_magic\":%llu,\"bad_version\":%llu,"
+                 "\"len_mismatch\":%llu,\"invalid_count\":%llu,"
+                 "\"compressed_packets\":%llu,\"decompress_failures\":%llu,"
+                 "\"fec_parity_packets\":%llu,\"fec_recovered\":%llu,"
+                 "\"fec_unrecoverable\":%llu},",
+                 LLU(ps.total_packets), LLU(ps.valid_packets),
+                 LLU(ps.crc_failures), LLU(ps.bad_magic), LLU(ps.bad_version),
+                 LLU(ps.len_mismatch), LLU(ps.invalid_count),
+                 LLU(ps.compressed_packets), LLU(ps.decompress_failures),
+                 LLU(ps.fec_parity_packets), LLU(ps.fec_recovered),
+                 LLU(ps.fec_unrecoverable));
+    off = append(buf, cap, off,
+                 "\"frame_builder\":{\"frames_built\":%llu,\"packets_added\":%llu,"
+                 "\"points_added\":%llu,\"late_packets\":%llu,\"seq_gaps\":%llu,"
+                 "\"seq_reorders\":%llu,\"overflow_frames\":%llu,"
+                 "\"voxel_dropped\":%llu},",
+                 LLU(fs.frames_built), LLU(fs.packets_added),
+                 LLU(fs.points_added), LLU(fs.late_packets), LLU(fs.seq_gaps),
+                 LLU(fs.seq_reorders), LLU(fs.overflow_frames),
+                 LLU(fs.voxel_dropped));
+    off = append(buf, cap, off,
+                 "\"rx\":{\"datagrams_received\":%llu,\"bytes_received\":%llu,"
+                 "\"recv_timeouts\":%llu,\"frames_queued\":%llu,"
+                 "\"queue_drops\":%llu,\"frames_recorded\":%llu,"
+                 "\"recvmmsg_calls\":%llu,\"burst_max\":%llu,"
+                 "\"echoes_sent\":%llu},",
+                 LLU(rs.datagrams_received), LLU(rs.bytes_received),
+                 LLU(rs.recv_timeouts), LLU(rs.frames_queued),
+                 LLU(rs.queue_drops), LLU(rs.frames_recorded),
+                 LLU(rs.recvmmsg_calls), LLU(rs.burst_max),
+                 LLU(rs.echoes_sent));
+#undef LLU
+    off = telemetry::histograms_json(buf, cap, off);
+    off = append(buf, cap, off, "}\n");
+    return off;
+}
+
+void LidarReceiver::enqueue_frame(Worker& worker,
+                                  frame_builder::Frame&& frame) {
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+
+        // Record before queueing so frames dropped by a slow consumer
+        // still land in the log (under queue_mutex_: the recorder is
+        // shared across workers; mmap memcpy, no syscalls per frame)
+        if (recorder_) {
+            recorder_->append(frame);
+            worker.rx_stats.frames_recorded++;
+        }
+
+        // Bounded queue: drop the oldest frame if Python is not draining
+        if (frame_queue_.size() >= queue_capacity_) {
+            frame_queue_.pop_front();
+            worker.rx_stats.queue_drops++;
+        }
+
+        frame_queue_.push_back(std::move(frame));
+        worker.rx_stats.frames_queued++;
+    }
+    queue_cv_.notify_one();
+}
+
+// Extract the kernel receive timestamp from a message's control data
+// (0 if SO_TIMESTAMPNS was unavailable)
+static int64_t kernel_rx_timestamp_ns(struct msghdr* hdr) {
+    for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(hdr); cmsg != nullptr;
+         cmsg = CMSG_NXTHDR(hdr, cmsg)) {
+        if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+            struct timespec ts;
+            std::memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+            return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+        }
+    }
+    return 0;
+}
+
+void LidarReceiver::rx_loop(Worker& worker) {
+    // Burst receive state, reused across every recvmmsg() call
+    // (stack-allocated per thread: workers must not share these)
+    uint8_t buffers[RECV_BURST][RECV_BUFFER_SIZE];
+    uint8_t cmsg_bufs[RECV_BURST][CMSG_SPACE(sizeof(struct timespec))];
+    struct sockaddr_in src_addrs[RECV_BURST];
+    struct iovec iov[RECV_BURST];
+    struct mmsghdr msgs[RECV_BURST];
+
+    std::memset(msgs, 0, sizeof(msgs));
+    for (unsigned i = 0; i < RECV_BURST; i++) {
+        iov[i].iov_base = buffers[i];
+        iov[i].iov_len = RECV_BUFFER_SIZE;
+        msgs[i].msg_hdr.msg_iov = &iov[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+        msgs[i].msg_hdr.msg_control = cmsg_bufs[i];
+        msgs[i].msg_hdr.msg_name = &src_addrs[i];
+    }
+
+    // Batch scratch (filled per burst, fed to add_packets_batch)
+    std::vector<ParsedPacket> parsed;
+    parsed.reserve(RECV_BURST);
+    int64_t ts_batch[RECV_BURST];
+    const float* xyz_batch[RECV_BURST];
+    size_t count_batch[RECV_BURST];
+    uint32_t seq_batch[RECV_BURST];
+
+    int64_t last_arrival_ns = 0;
+    uint64_t echo_countdown = 0;
+
+    while (running_.load(std::memory_order_relaxed)) {
+        // Reset the fields recvmmsg() overwrites
+        for (unsigned i = 0; i < RECV_BURST; i++) {
+            msgs[i].msg_hdr.msg_controllen = sizeof(cmsg_bufs[i]);
+            msgs[i].msg_hdr.msg_namelen = sizeof(src_addrs[i]);
+            msgs[i].msg_hdr.msg_flags = 0;
+        }
+
+        // MSG_WAITFORONE: block (up to SO_RCVTIMEO) for the first datagram,
+        // then drain whatever else is already queued without waiting
+        int received = recvmmsg(worker.sock_fd, msgs, RECV_BURST,
+                                MSG_WAITFORONE, nullptr);
+
+        if (received < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+                worker.rx_stats.recv_timeouts++;
+                continue;  // Idle link or signal: re-check running_
+            }
+            std::cerr << "[RX] recvmmsg failed (port " << worker.port << "): "
+                      << strerror(errno) << std::endl;
+            break;
+        }
+
+        worker.rx_stats.recvmmsg_calls++;
+        if (static_cast<uint64_t>(received) > worker.rx_stats.burst_max) {
+            worker.rx_stats.burst_max = static_cast<uint64_t>(received);
+        }
+
+        // Parse the burst
+        parsed.clear();
+        for (int i = 0; i < received; i++) {
+            size_t length = msgs[i].msg_len;
+            worker.rx_stats.datagrams_received++;
+            worker.rx_stats.bytes_received += length;
+
+            // Kernel arrival gap (unskewed by this loop's scheduling)
+            int64_t arrival_ns = kernel_rx_timestamp_ns(&msgs[i].msg_hdr);
+            if (arrival_ns > 0) {
+                if (last_arrival_ns > 0 && arrival_ns > last_arrival_ns) {
+                    g_arrival_hist->record_ns(
+                        static_cast<uint64_t>(arrival_ns - last_arrival_ns));
+                }
+                last_arrival_ns = arrival_ns;
+            }
+
+            auto parse_start = std::chrono::steady_clock::now();
+            auto packet = worker.protocol.parse_datagram(buffers[i], length);
+            g_parse_hist->record_ns(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - parse_start).count());
+            if (packet.has_value()) {
+                // Echo every Nth latency-probe packet back to its source
+                // (the sender's socket). Best effort: a lost echo just
+                // means one less RTT sample.
+                if (echo_sample_ > 0 && packet->host_send_ns != 0 &&
+                    ++echo_countdown >= (uint64_t)echo_sample_) {
+                    echo_countdown = 0;
+                    LatencyEcho echo;
+                    echo.magic = ECHO_MAGIC;
+                    echo.seq = packet->seq;
+                    echo.host_send_ns = packet->host_send_ns;
+                    // Kernel arrival stamp when available (per-run the
+                    // clock choice is constant, so offset estimates stay
+                    // consistent); fall back to userspace receipt time
+                    echo.rx_recv_ns = arrival_ns > 0
+                        ? (uint64_t)arrival_ns
+                        : (uint64_t)std::chrono::duration_cast<
+                              std::chrono::nanoseconds>(
+                              std::chrono::system_clock::now()
+                                  .time_since_epoch()).count();
+                    if (sendto(worker.sock_fd, &echo, sizeof(echo), 0,
+                               reinterpret_cast<struct sockaddr*>(&src_addrs[i]),
+                               sizeof(src_addrs[i])) == sizeof(echo)) {
+                        worker.rx_stats.echoes_sent++;
+                    }
+                }
+                parsed.push_back(std::move(*packet));
+            }
+        }
+
+        if (parsed.empty()) {
+            continue;  // Whole burst invalid: counted in protocol stats
+        }
+
+        // Accumulate the burst in one frame-builder call (arrays filled
+        // after parsing so vector growth cannot invalidate the pointers)
+        for (size_t i = 0; i < parsed.size(); i++) {
+            ts_batch[i] = static_cast<int64_t>(parsed[i].device_ts_ns);
+            xyz_batch[i] = parsed[i].xyz_data.data();
+            count_batch[i] = parsed[i].point_count;
+            seq_batch[i] = parsed[i].seq;
+        }
+
+        auto frames = worker.builder.add_packets_batch(
+            ts_batch, xyz_batch, count_batch, seq_batch, parsed.size());
+
+        for (auto& frame : frames) {
+            enqueue_frame(worker, std::move(frame));
+        }
+    }
+
+    // Flush the partial frame on shutdown
+    auto remaining = worker.builder.flush();
+    if (remaining.has_value()) {
+        enqueue_frame(worker, std::move(*remaining));
+    }
+
+    // Wake any blocked pop_frame() caller
+    queue_cv_.notify_all();
+}
+
+} // namespace lidar_rx
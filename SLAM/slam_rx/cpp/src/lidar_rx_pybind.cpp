@@ -0,0 +1,250 @@
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include <pybind11/numpy.h>
+#include "lidar_rx_cpp.hpp"
+
+namespace py = pybind11;
+using namespace lidar_rx;
+
+// ============================================================================
+// Helper: Convert Frame to Python dict (matching frame_builder_cpp API)
+// ============================================================================
+
+// The xyz vector is moved onto the heap and owned by the NumPy capsule,
+// so a completed frame crosses the pybind boundary without a copy.
+static py::object frame_to_dict(frame_builder::Frame&& frame) {
+    py::dict result;
+
+    size_t point_count = frame.point_count;
+    auto* owner = new std::vector<float>(std::move(frame.xyz_data));
+
+    py::capsule xyz_capsule(owner, [](void* p) {
+        delete static_cast<std::vector<float>*>(p);
+    });
+
+    std::vector<py::ssize_t> xyz_shape = {static_cast<py::ssize_t>(point_count), 3};
+    std::vector<py::ssize_t> xyz_strides = {3 * sizeof(float), sizeof(float)};
+
+    py::array_t<float> xyz_array(xyz_shape, xyz_strides, owner->data(), xyz_capsule);
+
+    result["xyz"] = xyz_array;
+    result["start_ts_ns"] = frame.start_ts_ns;
+    result["end_ts_ns"] = frame.end_ts_ns;
+    result["seq_first"] = frame.seq_first;
+    result["seq_last"] = frame.seq_last;
+    result["pkt_count"] = frame.pkt_count;
+    result["point_count"] = point_count;
+    result["sensor_id"] = frame.sensor_id;
+    result["aabb_min"] = py::make_tuple(frame.aabb_min[0], frame.aabb_min[1],
+                                        frame.aabb_min[2]);
+    result["aabb_max"] = py::make_tuple(frame.aabb_max[0], frame.aabb_max[1],
+                                        frame.aabb_max[2]);
+    result["centroid"] = py::make_tuple(frame.centroid[0], frame.centroid[1],
+                                        frame.centroid[2]);
+
+    return result;
+}
+
+// ============================================================================
+// Python-compatible wrapper for LidarReceiver
+// ============================================================================
+
+// Stats are exported as plain dicts (not bound classes) so this module can
+// be imported alongside lidar_protocol_cpp / frame_builder_cpp without
+// duplicate pybind type registrations.
+class LidarReceiverPy {
+public:
+    LidarReceiverPy(const std::string& bind_ip,
+                    uint16_t port,
+                    double frame_period_s,
+                    size_t max_frame_points,
+                    bool validate_crc,
+                    size_t queue_capacity,
+                    double voxel_size,
+                    const std::string& record_path,
+                    int telemetry_port,
+                    const std::vector<uint16_t>& ports,
+                    int echo_sample)
+        : receiver_(bind_ip,
+                    ports.empty() ? std::vector<uint16_t>{port} : ports,
+                    frame_period_s, max_frame_points, validate_crc,
+                    queue_capacity, voxel_size, record_path,
+                    telemetry_port, echo_sample) {}
+
+    bool start() { return receiver_.start(); }
+
+    void stop() {
+        // Stop joins the rx thread: release the GIL so a frame handoff
+        // in flight can never deadlock against us
+        py::gil_scoped_release release;
+        receiver_.stop();
+    }
+
+    bool is_running() const { return receiver_.is_running(); }
+
+    size_t queue_depth() { return receiver_.queue_depth(); }
+
+    // Pop next frame (blocks up to timeout_s with the GIL released)
+    py::object pop_frame(double timeout_s) {
+        std::optional<frame_builder::Frame> frame;
+        {
+            py::gil_scoped_release release;
+            frame = receiver_.pop_frame(timeout_s);
+        }
+
+        if (!frame.has_value()) {
+            return py::none();
+        }
+        return frame_to_dict(std::move(*frame));
+    }
+
+    // Snapshot of all pipeline counters as one dict
+    // (aggregated across workers)
+    py::dict stats() const {
+        py::dict result;
+        result["worker_count"] = receiver_.worker_count();
+        result["protocol"] = proto_dict(receiver_.protocol_stats());
+        result["frame_builder"] = frames_dict(receiver_.frame_stats());
+        result["rx"] = rx_dict(receiver_.rx_stats());
+        return result;
+    }
+
+    size_t worker_count() const { return receiver_.worker_count(); }
+
+    // Per-worker counter snapshot (same shape as stats(), plus the port)
+    py::dict worker_stats(size_t i) const {
+        if (i >= receiver_.worker_count()) {
+            throw py::index_error("worker index out of range");
+        }
+        py::dict result;
+        result["port"] = receiver_.worker_port(i);
+        result["protocol"] = proto_dict(receiver_.protocol_stats(i));
+        result["frame_builder"] = frames_dict(receiver_.frame_stats(i));
+        result["rx"] = rx_dict(receiver_.rx_stats(i));
+        return result;
+    }
+
+private:
+    static py::dict proto_dict(const ProtocolStats& ps) {
+        py::dict proto;
+        proto["total_packets"] = ps.total_packets;
+        proto["valid_packets"] = ps.valid_packets;
+        proto["crc_failures"] = ps.crc_failures;
+        proto["bad_magic"] = ps.bad_magic;
+        proto["bad_version"] = ps.bad_version;
+        proto["len_mismatch"] = ps.len_mismatch;
+        proto["invalid_count"] = ps.invalid_count;
+        proto["compressed_packets"] = ps.compressed_packets;
+        proto["decompress_failures"] = ps.decompress_failures;
+        proto["fec_parity_packets"] = ps.fec_parity_packets;
+        proto["fec_recovered"] = ps.fec_recovered;
+        proto["fec_unrecoverable"] = ps.fec_unrecoverable;
+        return proto;
+    }
+
+    static py::dict frames_dict(const frame_builder::FrameBuilderStats& fs) {
+        py::dict frames;
+        frames["frames_built"] = fs.frames_built;
+        frames["packets_added"] = fs.packets_added;
+        frames["points_added"] = fs.points_added;
+        frames["late_packets"] = fs.late_packets;
+        frames["seq_gaps"] = fs.seq_gaps;
+        frames["seq_reorders"] = fs.seq_reorders;
+        frames["overflow_frames"] = fs.overflow_frames;
+        frames["voxel_dropped"] = fs.voxel_dropped;
+        frames["memcpy_calls"] = fs.memcpy_calls;
+        frames["memcpy_bytes"] = fs.memcpy_bytes;
+        return frames;
+    }
+
+    static py::dict rx_dict(const RxStats& rs) {
+        py::dict rx;
+        rx["datagrams_received"] = rs.datagrams_received;
+        rx["bytes_received"] = rs.bytes_received;
+        rx["recv_timeouts"] = rs.recv_timeouts;
+        rx["frames_queued"] = rs.frames_queued;
+        rx["queue_drops"] = rs.queue_drops;
+        rx["frames_recorded"] = rs.frames_recorded;
+        rx["recvmmsg_calls"] = rs.recvmmsg_calls;
+        rx["burst_max"] = rs.burst_max;
+        rx["echoes_sent"] = rs.echoes_sent;
+        return rx;
+    }
+
+    LidarReceiver receiver_;
+};
+
+// ============================================================================
+// pybind11 module definition
+// ============================================================================
+
+PYBIND11_MODULE(lidar_rx_cpp, m) {
+    m.doc() = "Native LiDAR RX Pipeline - UDP receive + parse + frame build in C++";
+
+    py::class_<LidarReceiverPy>(m, "LidarReceiver")
+        .def(py::init<const std::string&, uint16_t, double, size_t, bool, size_t, double,
+                      const std::string&, int, const std::vector<uint16_t>&, int>(),
+             py::arg("bind_ip") = "0.0.0.0",
+             py::arg("port") = 9999,
+             py::arg("frame_period_s") = 0.1,
+             py::arg("max_frame_points") = 120000,
+             py::arg("validate_crc") = true,
+             py::arg("queue_capacity") = 8,
+             py::arg("voxel_size") = 0.0,
+             py::arg("record_path") = "",
+             py::arg("telemetry_port") = 0,
+             py::arg("ports") = std::vector<uint16_t>{},
+             py::arg("echo_sample") = 0,
+             "Initialize native receiver\n\n"
+             "Args:\n"
+             "    bind_ip (str): Local bind address (default: 0.0.0.0)\n"
+             "    port (int): UDP port to listen on\n"
+             "    frame_period_s (float): Frame window duration\n"
+             "    max_frame_points (int): Maximum points per frame\n"
+             "    validate_crc (bool): Enable CRC32 validation\n"
+             "    queue_capacity (int): Max queued frames before oldest is dropped\n"
+             "    voxel_size (float): Voxel leaf size in meters; > 0 enables\n"
+             "        voxel-grid downsampling inside the frame builder\n"
+             "    record_path (str): Record every completed frame to this frame\n"
+             "        log (replay with frame_log_cpp.FrameLogReader); '' disables\n"
+             "    telemetry_port (int): Serve JSON counter snapshots over UDP\n"
+             "        on this port (any datagram gets one reply); 0 disables\n"
+             "    ports (list[int]): Multi-sensor mode: one worker thread +\n"
+             "        socket + parser + frame builder per port (overrides\n"
+             "        'port'); [] keeps the single-port behavior\n"
+             "    echo_sample (int): Echo every Nth latency-probe packet\n"
+             "        back to the sender (RTT/offset measurement, see the\n"
+             "        sender's --latency-probe); 0 disables")
+        .def("start", &LidarReceiverPy::start,
+             "Open the sockets and start the receive threads\n\n"
+             "Returns:\n"
+             "    bool: True on success")
+        .def("stop", &LidarReceiverPy::stop,
+             "Stop the receive threads, flush pending frames, close the sockets")
+        .def("is_running", &LidarReceiverPy::is_running,
+             "Whether the receive threads are running")
+        .def("queue_depth", &LidarReceiverPy::queue_depth,
+             "Number of completed frames currently queued")
+        .def("pop_frame", &LidarReceiverPy::pop_frame,
+             py::arg("timeout_s") = 0.2,
+             "Pop the next completed frame (blocks with the GIL released)\n\n"
+             "Args:\n"
+             "    timeout_s (float): Max time to wait for a frame\n\n"
+             "Returns:\n"
+             "    dict or None: Frame dict (same keys as frame_builder_cpp)\n"
+             "        or None on timeout")
+        .def("stats", &LidarReceiverPy::stats,
+             "Snapshot of all pipeline counters (aggregated across workers)\n\n"
+             "Returns:\n"
+             "    dict: {'worker_count': N, 'protocol': {...},\n"
+             "        'frame_builder': {...}, 'rx': {...}}")
+        .def("worker_count", &LidarReceiverPy::worker_count,
+             "Number of receive workers (one per port)")
+        .def("worker_stats", &LidarReceiverPy::worker_stats,
+             py::arg("index"),
+             "Counter snapshot for one worker\n\n"
+             "Args:\n"
+             "    index (int): Worker index, 0 <= index < worker_count()\n\n"
+             "Returns:\n"
+             "    dict: Same shape as stats() plus the worker's 'port'");
+}
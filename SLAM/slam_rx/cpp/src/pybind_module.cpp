@@ -5,8 +5,47 @@
 
 namespace py = pybind11;
 
+// Helper: Wrap a std::vector<float> as an (N, cols) NumPy array with zero copy.
+// The vector's storage is moved onto the heap and freed by the capsule when
+// the array is garbage-collected, so the data built by parse_datagram()
+// crosses the pybind boundary without an additional allocation or memcpy.
+py::array_t<float> vector_to_array(std::vector<float>&& data, size_t n_rows, size_t n_cols) {
+    auto* owner = new std::vector<float>(std::move(data));
+
+    py::capsule capsule(owner, [](void* p) {
+        delete static_cast<std::vector<float>*>(p);
+    });
+
+    std::vector<py::ssize_t> shape = {static_cast<py::ssize_t>(n_rows),
+                                      static_cast<py::ssize_t>(n_cols)};
+    std::vector<py::ssize_t> strides = {static_cast<py::ssize_t>(n_cols * sizeof(float)),
+                                        sizeof(float)};
+
+    return py::array_t<float>(shape, strides, owner->data(), capsule);
+}
+
+// Helper: Wrap a 1-D metadata vector as a NumPy array with zero copy
+// (same capsule-ownership scheme as vector_to_array)
+template <typename T>
+py::array_t<T> meta_vector_to_array(std::vector<T>&& data) {
+    auto* owner = new std::vector<T>(std::move(data));
+
+    py::capsule capsule(owner, [](void* p) {
+        delete static_cast<std::vector<T>*>(p);
+    });
+
+    return py::array_t<T>(
+        {static_cast<py::ssize_t>(owner->size())},
+        {static_cast<py::ssize_t>(sizeof(T))},
+        owner->data(),
+        capsule
+    );
+}
+
 // Helper: Convert ParsedPacket to Python dict (matching Python API)
-py::object packet_to_dict(const ParsedPacket& packet) {
+// Takes the packet by value and moves its point storage into the NumPy
+// arrays -- no per-packet copies.
+py::object packet_to_dict(ParsedPacket&& packet) {
     py::dict result;
 
     result["device_ts_ns"] = packet.device_ts_ns;
@@ -15,48 +54,13 @@ py::object packet_to_dict(const ParsedPacket& packet) {
     result["sensor_id"] = packet.sensor_id;
     result["flags"] = packet.flags;
     result["crc32"] = packet.crc32;
+    result["host_send_ns"] = packet.host_send_ns;
 
-    // Create NumPy arrays with zero-copy (data ownership transferred to Python)
     size_t n_points = packet.point_count;
 
-    // points: (N, 4) array
-    auto* points_data = new float[n_points * 4];
-    std::memcpy(points_data, packet.points_data.data(), n_points * 4 * sizeof(float));
-
-    py::capsule points_capsule(points_data, [](void* p) {
-        delete[] static_cast<float*>(p);
-    });
-
-    std::vector<py::ssize_t> points_shape = {static_cast<py::ssize_t>(n_points), 4};
-    std::vector<py::ssize_t> points_strides = {4 * sizeof(float), sizeof(float)};
-
-    py::array_t<float> points(
-        points_shape,
-        points_strides,
-        points_data,
-        points_capsule
-    );
-
-    // xyz: (N, 3) array
-    auto* xyz_data = new float[n_points * 3];
-    std::memcpy(xyz_data, packet.xyz_data.data(), n_points * 3 * sizeof(float));
-
-    py::capsule xyz_capsule(xyz_data, [](void* p) {
-        delete[] static_cast<float*>(p);
-    });
-
-    std::vector<py::ssize_t> xyz_shape = {static_cast<py::ssize_t>(n_points), 3};
-    std::vector<py::ssize_t> xyz_strides = {3 * sizeof(float), sizeof(float)};
-
-    py::array_t<float> xyz(
-        xyz_shape,
-        xyz_strides,
-        xyz_data,
-        xyz_capsule
-    );
-
-    result["points"] = points;
-    result["xyz"] = xyz;
+    // points: (N, 4), xyz: (N, 3) -- ownership moved, zero additional copies
+    result["points"] = vector_to_array(std::move(packet.points_data), n_points, 4);
+    result["xyz"] = vector_to_array(std::move(packet.xyz_data), n_points, 3);
 
     return result;
 }
@@ -93,8 +97,64 @@ public:
             return py::none();
         }
 
-        // Convert to Python dict
-        return packet_to_dict(*result);
+        // Convert to Python dict (moves point storage into NumPy arrays)
+        return packet_to_dict(std::move(*result));
+    }
+
+    // Parse a burst of datagrams in one call (GIL released during parsing)
+    py::object parse_datagrams(py::list datagrams, bool debug = false) {
+        size_t count = py::len(datagrams);
+
+        // Extract raw buffers up front (while holding the GIL)
+        std::vector<py::bytes> keepalive;
+        std::vector<const uint8_t*> ptrs;
+        std::vector<size_t> lens;
+        keepalive.reserve(count);
+        ptrs.reserve(count);
+        lens.reserve(count);
+
+        for (size_t i = 0; i < count; i++) {
+            py::bytes item = datagrams[i].cast<py::bytes>();
+
+            char* buffer;
+            ssize_t length;
+            if (PYBIND11_BYTES_AS_STRING_AND_SIZE(item.ptr(), &buffer, &length) == -1) {
+                throw std::runtime_error("Failed to extract bytes at index " +
+                                         std::to_string(i));
+            }
+
+            ptrs.push_back(reinterpret_cast<const uint8_t*>(buffer));
+            lens.push_back(static_cast<size_t>(length));
+            keepalive.push_back(std::move(item));
+        }
+
+        // Parse the entire burst in C++ with the GIL released
+        ParsedBatch batch;
+        {
+            py::gil_scoped_release release;
+            batch = protocol_.parse_datagrams(ptrs.data(), lens.data(), count, debug);
+        }
+
+        // Sync stats to external Python object if provided
+        if (!external_stats_.is_none()) {
+            sync_stats_to_python();
+        }
+
+        // One dict per burst: concatenated points + per-packet metadata
+        py::dict result;
+        result["packet_count"] = batch.packet_count;
+        result["total_points"] = batch.total_points;
+        result["points"] = vector_to_array(std::move(batch.points_data),
+                                           batch.total_points, 4);
+        result["xyz"] = vector_to_array(std::move(batch.xyz_data),
+                                        batch.total_points, 3);
+        result["device_ts_ns"] = meta_vector_to_array(std::move(batch.device_ts_ns));
+        result["seq"] = meta_vector_to_array(std::move(batch.seq));
+        result["point_count"] = meta_vector_to_array(std::move(batch.point_counts));
+        result["sensor_id"] = meta_vector_to_array(std::move(batch.sensor_ids));
+        result["host_send_ns"] = meta_vector_to_array(std::move(batch.host_send_ns));
+
+        return result;
     }
 
     // CRC32 calculation (for testing/debugging)
@@ -128,6 +188,11 @@ private:
         external_stats_.attr("bad_version") = s.bad_version;
         external_stats_.attr("len_mismatch") = s.len_mismatch;
         external_stats_.attr("invalid_count") = s.invalid_count;
+        external_stats_.attr("compressed_packets") = s.compressed_packets;
+        external_stats_.attr("decompress_failures") = s.decompress_failures;
+        external_stats_.attr("fec_parity_packets") = s.fec_parity_packets;
+        external_stats_.attr("fec_recovered") = s.fec_recovered;
+        external_stats_.attr("fec_unrecoverable") = s.fec_unrecoverable;
     }
 };
 
@@ -152,6 +217,11 @@ PYBIND11_MODULE(lidar_protocol_cpp, m) {
         .def_readwrite("bad_version", &ProtocolStats::bad_version)
         .def_readwrite("len_mismatch", &ProtocolStats::len_mismatch)
         .def_readwrite("invalid_count", &ProtocolStats::invalid_count)
+        .def_readwrite("compressed_packets", &ProtocolStats::compressed_packets)
+        .def_readwrite("decompress_failures", &ProtocolStats::decompress_failures)
+        .def_readwrite("fec_parity_packets", &ProtocolStats::fec_parity_packets)
+        .def_readwrite("fec_recovered", &ProtocolStats::fec_recovered)
+        .def_readwrite("fec_unrecoverable", &ProtocolStats::fec_unrecoverable)
         .def("reset", &ProtocolStats::reset)
         .def("__repr__", &ProtocolStats::repr);
 
@@ -183,6 +253,29 @@ PYBIND11_MODULE(lidar_protocol_cpp, m) {
              "            'points': np.ndarray (N, 4) [x, y, z, intensity],\n"
              "            'xyz': np.ndarray (N, 3) [x, y, z only]\n"
              "        }")
+        .def("parse_datagrams", &LidarProtocolPy::parse_datagrams,
+             py::arg("datagrams"),
+             py::arg("debug") = false,
+             "Parse a burst of UDP datagrams in one call\n\n"
+             "Parsing runs in C++ with the GIL released; invalid datagrams\n"
+             "are skipped and counted in stats.\n\n"
+             "Args:\n"
+             "    datagrams (list[bytes]): Raw UDP packets (e.g. one recvmmsg burst)\n"
+             "    debug (bool): Enable debug logging\n\n"
+             "Returns:\n"
+             "    dict: Concatenated batch result\n"
+             "        {\n"
+             "            'packet_count': int (valid packets),\n"
+             "            'total_points': int,\n"
+             "            'points': np.ndarray (total_points, 4),\n"
+             "            'xyz': np.ndarray (total_points, 3),\n"
+             "            'device_ts_ns': np.ndarray (packet_count,) uint64,\n"
+             "            'seq': np.ndarray (packet_count,) uint32,\n"
+             "            'point_count': np.ndarray (packet_count,) uint16,\n"
+             "            'sensor_id': np.ndarray (packet_count,) uint16,\n"
+             "            'host_send_ns': np.ndarray (packet_count,) uint64\n"
+             "                (FLAG_HOST_TS trailer, 0 = not present)\n"
+             "        }")
         .def("crc32_ieee802_3", &LidarProtocolPy::crc32_ieee802_3,
              py::arg("data"),
              "Calculate IEEE 802.3 CRC32\n\n"
@@ -0,0 +1,359 @@
+// slam_rx_bench - Micro-benchmark suite for the rx hot paths
+//
+// Synthesizes realistic LIVR packet streams (105-point packets by default,
+// configurable rate, sequence gaps, CRC validation on/off) and measures
+// each pipeline stage in isolation plus end-to-end:
+//
+//   crc32      - LidarProtocol::crc32_ieee over a full datagram
+//   parse      - LidarProtocol::parse_datagram
+//   accumulate - FrameBuilder::add_packet (packets pre-parsed)
+//   pipeline   - parse_datagram + add_packet (what rx_loop does per datagram)
+//
+// Reports ns/packet percentiles (after warmup), aggregate points/sec, and
+// heap allocation counts per packet, so a change to any hot path can be
+// proven faster or flagged as a regression without a live sensor.
+//
+// Usage: slam_rx_bench [options]
+//   --packets N     Packets per stage          (default: 100000)
+//   --points N      Points per packet, 1-105   (default: 105)
+//   --pps N         Simulated packet rate      (default: 4000)
+//   --gap-every N   Drop every Nth sequence    (default: 0 = no gaps)
+//   --no-crc        Disable CRC validation in the parser
+//   --quantize      Generate v2 quantized packets (193 pts max)
+//   --warmup N      Warmup packets per stage   (default: 5000)
+
+#include "lidar_protocol_cpp.hpp"
+#include "frame_builder_cpp.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <zlib.h>
+
+// ============================================================================
+// Heap allocation counting (global operator new/delete instrumentation)
+// ============================================================================
+
+static std::atomic<uint64_t> g_alloc_count{0};
+
+void* operator new(size_t size) {
+    g_alloc_count.fetch_add(1, std::memory_order_relaxed);
+    void* p = malloc(size);
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+// ============================================================================
+// Timing helpers
+// ============================================================================
+
+static inline uint64_t now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+}
+
+// Percentile from a sorted sample vector
+static uint64_t percentile(const std::vector<uint64_t>& sorted, double p) {
+    if (sorted.empty()) return 0;
+    size_t idx = static_cast<size_t>(p * (sorted.size() - 1));
+    return sorted[idx];
+}
+
+// ============================================================================
+// Packet synthesis
+// ============================================================================
+
+struct BenchConfig {
+    size_t packets = 100000;
+    size_t points = MAX_POINTS_PER_PACKET;
+    size_t pps = 4000;
+    size_t gap_every = 0;
+    bool validate_crc = true;
+    bool quantize = false;
+    size_t warmup = 5000;
+};
+
+struct SynthPacket {
+    std::vector<uint8_t> data;
+};
+
+// Build a stream of valid datagrams matching what lidar_tx sends: seeded
+// RNG so repeated runs measure identical inputs
+static std::vector<SynthPacket> synthesize_stream(const BenchConfig& cfg) {
+    std::vector<SynthPacket> stream;
+    stream.reserve(cfg.packets);
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> coord(-50.0f, 50.0f);
+    std::uniform_int_distribution<int> inten(0, 255);
+
+    const uint64_t ts_step_ns = 1000000000ULL / (cfg.pps > 0 ? cfg.pps : 1);
+    uint64_t ts = 1000000000ULL;
+    uint32_t seq = 0;
+
+    for (size_t i = 0; i < cfg.packets; i++) {
+        // Simulated loss: skip a sequence number every gap_every packets
+        if (cfg.gap_every > 0 && i > 0 && i % cfg.gap_every == 0) {
+            seq++;
+        }
+
+        size_t payload_size = cfg.quantize
+            ? QUANT_BLOCK_SIZE + cfg.points * QUANT_POINT_SIZE
+            : cfg.points * POINT_SIZE;
+
+        SynthPacket pkt;
+        pkt.data.resize(HEADER_SIZE + payload_size);
+
+        PacketHeader header;
+        header.magic = LIDAR_MAGIC;
+        header.version = LIDAR_VERSION;
+        header.device_ts_ns = ts;
+        header.seq = seq;
+        header.point_count = static_cast<uint16_t>(cfg.points);
+        header.flags = cfg.quantize ? FLAG_QUANT_POINTS : 0;
+        header.sensor_id = 0;
+        header.crc32 = 0;
+
+        uint8_t* payload = pkt.data.data() + HEADER_SIZE;
+        if (cfg.quantize) {
+            QuantBlock block;
+            block.offset_x = coord(rng);
+            block.offset_y = coord(rng);
+            block.offset_z = coord(rng);
+            block.scale = 0.001f;
+            std::memcpy(payload, &block, QUANT_BLOCK_SIZE);
+            std::uniform_int_distribution<int> q(-32767, 32767);
+            for (size_t p = 0; p < cfg.points; p++) {
+                QuantPoint qp;
+                qp.x = static_cast<int16_t>(q(rng));
+                qp.y = static_cast<int16_t>(q(rng));
+                qp.z = static_cast<int16_t>(q(rng));
+                qp.intensity = static_cast<uint8_t>(inten(rng));
+                std::memcpy(payload + QUANT_BLOCK_SIZE + p * QUANT_POINT_SIZE,
+                            &qp, QUANT_POINT_SIZE);
+            }
+        } else {
+            for (size_t p = 0; p < cfg.points; p++) {
+                Point pt;
+                pt.x = coord(rng);
+                pt.y = coord(rng);
+                pt.z = coord(rng);
+                pt.intensity = static_cast<uint8_t>(inten(rng));
+                std::memcpy(payload + p * POINT_SIZE, &pt, POINT_SIZE);
+            }
+        }
+
+        // CRC over header[0..22] + payload, exactly as tx computes it
+        // (zlib IEEE 802.3, crc32 field excluded)
+        std::memcpy(pkt.data.data(), &header, HEADER_SIZE);
+        uint32_t crc = ::crc32(0, pkt.data.data(), HEADER_SIZE - 4);
+        header.crc32 = ::crc32(crc, payload, payload_size);
+        std::memcpy(pkt.data.data(), &header, HEADER_SIZE);
+
+        stream.push_back(std::move(pkt));
+        ts += ts_step_ns;
+        seq++;
+    }
+
+    return stream;
+}
+
+// ============================================================================
+// Benchmark harness
+// ============================================================================
+
+struct StageResult {
+    std::string name;
+    size_t packets = 0;
+    size_t points = 0;
+    uint64_t total_ns = 0;
+    uint64_t allocs = 0;
+    std::vector<uint64_t> samples;  // ns per packet, unsorted
+};
+
+static void report(const StageResult& r) {
+    std::vector<uint64_t> sorted = r.samples;
+    std::sort(sorted.begin(), sorted.end());
+
+    double mean_ns = r.packets > 0
+        ? static_cast<double>(r.total_ns) / r.packets : 0.0;
+    double pts_per_sec = r.total_ns > 0
+        ? static_cast<double>(r.points) * 1e9 / r.total_ns : 0.0;
+    double allocs_per_pkt = r.packets > 0
+        ? static_cast<double>(r.allocs) / r.packets : 0.0;
+
+    printf("%-12s %9zu pkts  mean %8.1f ns  p50 %7lu  p95 %7lu  "
+           "p99 %7lu  max %8lu  %8.2f Mpts/s  %.2f allocs/pkt\n",
+           r.name.c_str(), r.packets, mean_ns,
+           (unsigned long)percentile(sorted, 0.50),
+           (unsigned long)percentile(sorted, 0.95),
+           (unsigned long)percentile(sorted, 0.99),
+           sorted.empty() ? 0UL : (unsigned long)sorted.back(),
+           pts_per_sec / 1e6, allocs_per_pkt);
+}
+
+// Run fn(i) over the stream with warmup, per-packet timing, and alloc counts
+template <typename Fn>
+static StageResult run_stage(const std::string& name,
+                             const BenchConfig& cfg,
+                             size_t points_per_packet,
+                             Fn&& fn) {
+    StageResult r;
+    r.name = name;
+
+    // Warmup: prime caches, branch predictors, and lazy CRC tables
+    size_t warmup = std::min(cfg.warmup, cfg.packets);
+    for (size_t i = 0; i < warmup; i++) {
+        fn(i);
+    }
+
+    r.samples.reserve(cfg.packets);
+    uint64_t allocs_before = g_alloc_count.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < cfg.packets; i++) {
+        uint64_t t0 = now_ns();
+        fn(i);
+        uint64_t dt = now_ns() - t0;
+        r.samples.push_back(dt);
+        r.total_ns += dt;
+    }
+    r.allocs = g_alloc_count.load(std::memory_order_relaxed) - allocs_before;
+
+    r.packets = cfg.packets;
+    r.points = cfg.packets * points_per_packet;
+    return r;
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+static void usage(const char* prog) {
+    printf("Usage: %s [--packets N] [--points N] [--pps N] [--gap-every N]\n"
+           "       %*s [--no-crc] [--quantize] [--warmup N]\n",
+           prog, (int)strlen(prog), "");
+}
+
+int main(int argc, char** argv) {
+    BenchConfig cfg;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--packets" && i + 1 < argc) {
+            cfg.packets = strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--points" && i + 1 < argc) {
+            cfg.points = strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--pps" && i + 1 < argc) {
+            cfg.pps = strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--gap-every" && i + 1 < argc) {
+            cfg.gap_every = strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--no-crc") {
+            cfg.validate_crc = false;
+        } else if (arg == "--quantize") {
+            cfg.quantize = true;
+        } else if (arg == "--warmup" && i + 1 < argc) {
+            cfg.warmup = strtoul(argv[++i], nullptr, 10);
+        } else {
+            usage(argv[0]);
+            return arg == "--help" || arg == "-h" ? 0 : 1;
+        }
+    }
+
+    size_t max_points = cfg.quantize
+        ? MAX_QUANT_POINTS_PER_PACKET : MAX_POINTS_PER_PACKET;
+    if (cfg.points < 1 || cfg.points > max_points) {
+        fprintf(stderr, "points must be 1-%zu for this encoding\n", max_points);
+        return 1;
+    }
+
+    printf("slam_rx_bench: %zu packets x %zu points, %zu pps, "
+           "gaps every %zu, crc %s, %s encoding, %zu warmup\n\n",
+           cfg.packets, cfg.points, cfg.pps, cfg.gap_every,
+           cfg.validate_crc ? "on" : "off",
+           cfg.quantize ? "quantized" : "raw", cfg.warmup);
+
+    std::vector<SynthPacket> stream = synthesize_stream(cfg);
+    const double frame_period_s = 0.1;
+    const size_t max_frame_points = 120000;
+
+    // --- Stage: crc32 ------------------------------------------------------
+    {
+        LidarProtocol proto(false);
+        volatile uint32_t sink = 0;
+        StageResult r = run_stage("crc32", cfg, cfg.points, [&](size_t i) {
+            const SynthPacket& pkt = stream[i];
+            sink = proto.crc32_ieee(pkt.data.data(), pkt.data.size());
+        });
+        report(r);
+    }
+
+    // --- Stage: parse ------------------------------------------------------
+    {
+        LidarProtocol proto(cfg.validate_crc);
+        StageResult r = run_stage("parse", cfg, cfg.points, [&](size_t i) {
+            const SynthPacket& pkt = stream[i];
+            auto parsed = proto.parse_datagram(pkt.data.data(), pkt.data.size());
+            if (!parsed.has_value()) {
+                fprintf(stderr, "parse failed at packet %zu\n", i);
+                exit(1);
+            }
+        });
+        report(r);
+    }
+
+    // --- Stage: accumulate (pre-parsed xyz, frame builder only) ------------
+    {
+        LidarProtocol proto(false);
+        std::vector<ParsedPacket> parsed;
+        parsed.reserve(cfg.packets);
+        for (const SynthPacket& pkt : stream) {
+            parsed.push_back(*proto.parse_datagram(pkt.data.data(), pkt.data.size()));
+        }
+
+        frame_builder::FrameBuilderStats fb_stats;
+        frame_builder::FrameBuilder builder(frame_period_s, max_frame_points, fb_stats);
+        size_t frames = 0;
+        StageResult r = run_stage("accumulate", cfg, cfg.points, [&](size_t i) {
+            const ParsedPacket& p = parsed[i];
+            auto frame = builder.add_packet(
+                static_cast<int64_t>(p.device_ts_ns),
+                p.xyz_data.data(), p.point_count, p.seq);
+            if (frame.has_value()) frames++;
+        });
+        report(r);
+        printf("             %zu frames closed, %lu seq gaps detected\n",
+               frames, (unsigned long)fb_stats.seq_gaps);
+    }
+
+    // --- Stage: pipeline (parse + accumulate, as rx_loop does) -------------
+    {
+        LidarProtocol proto(cfg.validate_crc);
+        frame_builder::FrameBuilderStats fb_stats;
+        frame_builder::FrameBuilder builder(frame_period_s, max_frame_points, fb_stats);
+        size_t frames = 0;
+        StageResult r = run_stage("pipeline", cfg, cfg.points, [&](size_t i) {
+            const SynthPacket& pkt = stream[i];
+            auto parsed = proto.parse_datagram(pkt.data.data(), pkt.data.size());
+            if (!parsed.has_value()) return;
+            auto frame = builder.add_packet(
+                static_cast<int64_t>(parsed->device_ts_ns),
+                parsed->xyz_data.data(), parsed->point_count, parsed->seq);
+            if (frame.has_value()) frames++;
+        });
+        report(r);
+        printf("             %zu frames closed\n", frames);
+    }
+
+    return 0;
+}